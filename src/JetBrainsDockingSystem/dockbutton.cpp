@@ -35,6 +35,8 @@ namespace JBDS {
     }
 
     void DockButtonPrivate::init() {
+        Q_Q(DockButton);
+        q->setAttribute(Qt::WA_Hover);
     }
 
     DockButton::DockButton(QWidget *parent) : DockButton(*new DockButtonPrivate(), parent) {
@@ -72,6 +74,38 @@ namespace JBDS {
         updateGeometry();
     }
 
+    QColor DockButton::hoverColor() const {
+        Q_D(const DockButton);
+        if (d->hoverColor.isValid())
+            return d->hoverColor;
+
+        auto color = palette().color(QPalette::Mid);
+        color.setAlpha(40);
+        return color;
+    }
+
+    void DockButton::setHoverColor(const QColor &color) {
+        Q_D(DockButton);
+        d->hoverColor = color;
+        update();
+    }
+
+    QColor DockButton::checkedColor() const {
+        Q_D(const DockButton);
+        if (d->checkedColor.isValid())
+            return d->checkedColor;
+
+        auto color = palette().color(QPalette::Mid);
+        color.setAlpha(80);
+        return color;
+    }
+
+    void DockButton::setCheckedColor(const QColor &color) {
+        Q_D(DockButton);
+        d->checkedColor = color;
+        update();
+    }
+
     void DockButton::paintEvent(QPaintEvent *event) {
         Q_D(DockButton);
 
@@ -81,6 +115,18 @@ namespace JBDS {
         QStyleOptionButton option;
         initStyleOption(&option);
 
+        // The style draws the button unless a color was set, the bevel is then replaced by a
+        // flat fill and only the label goes through the style. Style sheet rules win.
+        bool native = (d->hoverColor.isValid() || d->checkedColor.isValid()) &&
+                      !testAttribute(Qt::WA_StyleSheetTarget);
+        if (native) {
+            if (isChecked() || isDown()) {
+                painter.fillRect(rect(), checkedColor());
+            } else if (underMouse()) {
+                painter.fillRect(rect(), hoverColor());
+            }
+        }
+
         if (d->orientation == TopToBottom) {
             painter.rotate(90);
             painter.translate(0, -1 * width());
@@ -90,7 +136,7 @@ namespace JBDS {
             painter.translate(-1 * height(), 0);
             option.rect = option.rect.transposed();
         }
-        painter.drawControl(QStyle::CE_PushButton, option);
+        painter.drawControl(native ? QStyle::CE_PushButtonLabel : QStyle::CE_PushButton, option);
     }
 
     DockButton::DockButton(DockButtonPrivate &d, QWidget *parent) : QPushButton(parent), d_ptr(&d) {
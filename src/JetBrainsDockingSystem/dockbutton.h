@@ -25,6 +25,8 @@ namespace JBDS {
     class JBDS_EXPORT DockButton : public QPushButton {
         Q_OBJECT
         Q_DECLARE_PRIVATE(DockButton)
+        Q_PROPERTY(QColor hoverColor READ hoverColor WRITE setHoverColor)
+        Q_PROPERTY(QColor checkedColor READ checkedColor WRITE setCheckedColor)
     public:
         explicit DockButton(QWidget *parent = nullptr);
         explicit DockButton(const QString &text, QWidget *parent = nullptr);
@@ -37,6 +39,13 @@ namespace JBDS {
         Orientation orientation() const;
         void setOrientation(Orientation orientation);
 
+        // Setting either paints the button flat with these instead of through the style, unless
+        // a style sheet targets it. The unset one is derived from the palette.
+        QColor hoverColor() const;
+        void setHoverColor(const QColor &color);
+        QColor checkedColor() const;
+        void setCheckedColor(const QColor &color);
+
     protected:
         void paintEvent(QPaintEvent *event) override;
 
@@ -28,6 +28,9 @@ namespace JBDS {
         DockButton *q_ptr;
 
         Orientation orientation = Horizontal;
+
+        QColor hoverColor;
+        QColor checkedColor;
     };
 
 }
@@ -12,6 +12,7 @@
 #include <QtWidgets/QStyleOption>
 
 #include "dockwidget_p.h"
+#include "jbdsperf_p.h"
 
 namespace JBDS {
 
@@ -70,6 +71,14 @@ namespace JBDS {
         auto dock_p = DockWidgetPrivate::get(m_dock);
         auto data = dock_p->buttonDataHash.value(button);
         auto orgSidebar = dock_p->bars[edge2index(data.edge)];
+
+        // Empty edges have no bar until now, they are drop targets as well
+        for (int i = 0; i < 4; ++i) {
+            if (!dock_p->barHidden[i]) {
+                dock_p->sideBar(i);
+            }
+        }
+
         if (orgSidebar->count(Front) + orgSidebar->count(Back) == 1) {
             button->setDisabled(true);
             button->installEventFilter(this);
@@ -96,6 +105,7 @@ namespace JBDS {
     }
 
     bool DockDragController::eventFilter(QObject *obj, QEvent *event) {
+        DockWidgetPrivate::get(m_dock)->counters.add(DockWidget::DragFilterEvents);
         if (obj == m_label) {
             switch (event->type()) {
                 case QEvent::MouseMove:
@@ -117,14 +127,18 @@ namespace JBDS {
     }
 
     void DockDragController::tabDragMove() {
+        JBDS_TRACE_SCOPE("DockDragController::tabDragMove");
         auto label = static_cast<DockDragLabel *>(m_label);
         label->move(QCursor::pos() - label->currentPos);
 
         auto button = label->currentButton;
         auto d = DockWidgetPrivate::get(m_dock);
+        d->counters.add(DockWidget::DragMoves);
 
         DockSideBar *targetBar = nullptr;
         for (auto bar : d->bars) {
+            if (!bar)
+                continue;
             if (!targetBar && bar->isEnabled() && bar->isVisible()) {
                 int widthHint = d->delegate->buttonOrientation(button) == Horizontal
                                     ? button->sizeHint().height()
@@ -161,11 +175,14 @@ namespace JBDS {
                 bar->setHighlight(false);
             }
         }
+        if (label->targetBar == targetBar) {
+            d->counters.add(DockWidget::DragMovesCoalesced);
+        }
         label->targetBar = targetBar;
     }
 
     static int buttonAtWidget(DockSideBar *sideBar, Side side, QWidget *w, bool reverse = false) {
-        auto buttons = sideBar->buttons(side);
+        const auto &buttons = sideBar->buttons(side);
         auto halfSpacing = sideBar->buttonLayout(side)->spacing() / 2;
 
         int index = 0;
@@ -199,6 +216,7 @@ namespace JBDS {
     };
 
     void DockDragController::tabDragOver() {
+        JBDS_TRACE_SCOPE("DockDragController::tabDragOver");
         auto label = static_cast<DockDragLabel *>(m_label);
         auto button = label->currentButton;
 
@@ -241,8 +259,9 @@ namespace JBDS {
             QTimer::singleShot(0, button, [pos, button, widget, viewMode, this]() {
                 if (viewMode == DockPinned) {
                     m_dock->setViewMode(button, Floating);
-                    DockWidgetPrivate::moveWidgetToPos(widget, pos);
-                } else if (!button->isChecked()) {
+                    if (widget)
+                        DockWidgetPrivate::moveWidgetToPos(widget, pos);
+                } else if (!button->isChecked() && widget) {
                     DockWidgetPrivate::moveWidgetToPos(widget, pos);
                 }
                 button->setChecked(true);
@@ -264,7 +283,8 @@ namespace JBDS {
         m_label = nullptr;
 
         for (auto bar : std::as_const(d->bars)) {
-            bar->setHighlight(false);
+            if (bar)
+                bar->setHighlight(false);
         }
     }
 
@@ -0,0 +1,196 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "dockhud_p.h"
+
+#include <QtCore/QTimerEvent>
+#include <QtGui/QFontDatabase>
+#include <QtGui/QPainter>
+
+#include "dockwidget_p.h"
+#include "jbdsperf_p.h"
+
+namespace JBDS {
+
+    static const int padding = 6;
+    static const int graphHeight = 48;
+    static const int tickInterval = 100; // Milliseconds
+    static const qint64 graphRange = 33333333; // Two 60 Hz frames, in nanoseconds
+
+    DockHud::DockHud(DockWidgetPrivate *d, QWidget *parent) : QWidget(parent), d(d) {
+        setObjectName("dock-hud");
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+        setFocusPolicy(Qt::NoFocus);
+        setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+        setFixedSize(300, padding * 3 + graphHeight + fontMetrics().height() * lineCount);
+        m_clock.start();
+    }
+
+    DockHud::~DockHud() {
+        if (m_timer.isActive()) {
+            traceListeners.fetch_sub(1, std::memory_order_relaxed);
+            unwatchWindow();
+        }
+    }
+
+    bool DockHud::eventFilter(QObject *obj, QEvent *event) {
+        if (event->type() != QEvent::UpdateRequest || m_frameBegin >= 0 ||
+            (obj != m_top && obj != m_handle))
+            return QWidget::eventFilter(obj, event);
+
+        // The frame is done once the request, which the window forwards to the top level
+        // widget, has been delivered
+        m_frameBegin = m_clock.nsecsElapsed();
+        QMetaObject::invokeMethod(
+            this,
+            [this]() {
+                m_frames[m_nextFrame] = m_clock.nsecsElapsed() - m_frameBegin;
+                m_nextFrame = (m_nextFrame + 1) % frameCount;
+                m_frameBegin = -1;
+            },
+            Qt::QueuedConnection);
+        return QWidget::eventFilter(obj, event);
+    }
+
+    void DockHud::showEvent(QShowEvent *event) {
+        QWidget::showEvent(event);
+        if (m_timer.isActive())
+            return;
+
+        traceListeners.fetch_add(1, std::memory_order_relaxed);
+        watchWindow();
+        m_maxLatency = 0;
+        m_lastTick = m_clock.nsecsElapsed();
+        m_timer.start(tickInterval, Qt::PreciseTimer, this);
+        prepare();
+    }
+
+    void DockHud::hideEvent(QHideEvent *event) {
+        QWidget::hideEvent(event);
+        if (!m_timer.isActive())
+            return;
+
+        m_timer.stop();
+        unwatchWindow();
+        traceListeners.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void DockHud::timerEvent(QTimerEvent *event) {
+        if (event->timerId() != m_timer.timerId()) {
+            QWidget::timerEvent(event);
+            return;
+        }
+
+        // How late the timer fired is what input would have waited, precise timers have no
+        // slack of their own
+        auto now = m_clock.nsecsElapsed();
+        m_latency = qMax<qint64>(0, now - m_lastTick - tickInterval * 1000000LL);
+        m_maxLatency = qMax(m_maxLatency, m_latency);
+        m_lastTick = now;
+
+        // The dock may have moved to another window
+        if (window() != m_top) {
+            unwatchWindow();
+            watchWindow();
+        }
+        prepare();
+    }
+
+    void DockHud::paintEvent(QPaintEvent *event) {
+        Q_UNUSED(event)
+
+        QPainter painter(this);
+        painter.fillRect(rect(), QColor(0, 0, 0, 176));
+
+        // Budget of a 60 Hz frame, halfway up the graph
+        int graphTop = padding;
+        int graphBottom = padding + graphHeight;
+        painter.setPen(QColor(255, 255, 255, 64));
+        painter.drawLine(padding, graphTop + graphHeight / 2, width() - padding,
+                         graphTop + graphHeight / 2);
+        painter.drawLine(padding, graphBottom, width() - padding, graphBottom);
+
+        painter.setPen(QColor(0x4c, 0xd9, 0x64));
+        painter.drawPolyline(m_graph, frameCount);
+
+        painter.setPen(Qt::white);
+        int lineHeight = fontMetrics().height();
+        int y = graphBottom + padding + fontMetrics().ascent();
+        for (const auto &line : m_lines) {
+            painter.drawText(padding, y, line);
+            y += lineHeight;
+        }
+    }
+
+    void DockHud::watchWindow() {
+        m_top = window();
+        m_top->installEventFilter(this);
+        m_handle = m_top->windowHandle();
+        if (m_handle) {
+            m_handle->installEventFilter(this);
+        }
+    }
+
+    void DockHud::unwatchWindow() {
+        if (m_top) {
+            m_top->removeEventFilter(this);
+        }
+        if (m_handle) {
+            m_handle->removeEventFilter(this);
+        }
+        m_top = nullptr;
+        m_handle = nullptr;
+    }
+
+    void DockHud::prepare() {
+        auto ms = [](qint64 nsecs) {
+            return QString::number(nsecs / 1e6, 'f', 1);
+        };
+
+        // Oldest frame on the left
+        qint64 sum = 0;
+        qint64 max = 0;
+        int measured = 0;
+        qreal step = qreal(width() - padding * 2) / (frameCount - 1);
+        for (int i = 0; i < frameCount; ++i) {
+            auto nsecs = m_frames[(m_nextFrame + i) % frameCount];
+            if (nsecs > 0) {
+                sum += nsecs;
+                max = qMax(max, nsecs);
+                measured++;
+            }
+            auto ratio = qreal(qMin(nsecs, graphRange)) / graphRange;
+            m_graph[i] = QPointF(padding + i * step, padding + graphHeight * (1 - ratio));
+        }
+        auto last = m_frames[(m_nextFrame + frameCount - 1) % frameCount];
+        m_lines[0] = QString("frame %1 ms  avg %2  max %3")
+                         .arg(ms(last), ms(measured ? sum / measured : 0), ms(max));
+        m_lines[1] = QString("event loop %1 ms  max %2").arg(ms(m_latency), ms(m_maxLatency));
+
+        const auto &counters = d->counters;
+        auto value = [&counters](DockWidget::Counter counter) {
+            return counters.values[counter].load(std::memory_order_relaxed);
+        };
+        m_lines[2] = QString("relayouts %1  drag moves %2")
+                         .arg(value(DockWidget::Relayouts))
+                         .arg(value(DockWidget::DragMoves));
+
+        static const char prefix[] = "DockWidget::";
+        DockTraceSpan spans[operationCount];
+        int count = recentTraceSpans(prefix, spans, operationCount);
+        for (int i = 0; i < operationCount; ++i) {
+            auto &line = m_lines[3 + i];
+            if (i >= count) {
+                line.clear();
+                continue;
+            }
+            const auto &span = spans[i];
+            line = QString("%1 %2 ms")
+                       .arg(QLatin1String(span.name + sizeof(prefix) - 1), -24)
+                       .arg(ms((span.end - span.begin) * 1000));
+        }
+        update();
+    }
+
+}
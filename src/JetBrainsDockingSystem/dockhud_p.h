@@ -0,0 +1,72 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKHUD_P_H
+#define DOCKHUD_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QBasicTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
+#include <QtGui/QWindow>
+#include <QtWidgets/QWidget>
+
+namespace JBDS {
+
+    class DockWidgetPrivate;
+
+    // Frame times of the window holding the dock, event loop latency, the latest operations
+    // and counters, drawn over the dock. Everything is measured into fixed buffers and
+    // formatted ten times a second, a paint only draws what was prepared.
+    class DockHud : public QWidget {
+    public:
+        explicit DockHud(DockWidgetPrivate *d, QWidget *parent = nullptr);
+        ~DockHud();
+
+        static constexpr int frameCount = 120;
+        static constexpr int operationCount = 6;
+        static constexpr int lineCount = operationCount + 3;
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+        void showEvent(QShowEvent *event) override;
+        void hideEvent(QHideEvent *event) override;
+        void timerEvent(QTimerEvent *event) override;
+        void paintEvent(QPaintEvent *event) override;
+
+    private:
+        DockWidgetPrivate *d;
+
+        QPointer<QWidget> m_top;
+        QPointer<QWindow> m_handle;
+        qint64 m_frameBegin = -1; // Of the frame being delivered
+        QElapsedTimer m_clock;
+
+        qint64 m_frames[frameCount] = {}; // Nanoseconds
+        int m_nextFrame = 0;
+
+        QBasicTimer m_timer;
+        qint64 m_lastTick = 0;
+        qint64 m_latency = 0;
+        qint64 m_maxLatency = 0;
+
+        // Prepared for paint
+        QPointF m_graph[frameCount];
+        QString m_lines[lineCount];
+
+        void watchWindow();
+        void unwatchWindow();
+        void prepare();
+    };
+
+}
+
+#endif // DOCKHUD_P_H
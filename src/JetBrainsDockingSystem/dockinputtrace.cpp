@@ -0,0 +1,440 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "dockinputtrace.h"
+#include "dockinputtrace_p.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFile>
+#include <QtCore/QTimer>
+#include <QtGui/QCursor>
+#include <QtGui/QtEvents>
+#include <QtWidgets/QApplication>
+
+#include "dockwidget_p.h"
+
+namespace JBDS {
+
+    static const quint32 traceMagic = 0x4A424454; // "JBDT"
+    static const quint16 traceVersion = 1;
+
+    static inline bool isMouseEvent(int type) {
+        return type == QEvent::MouseButtonPress || type == QEvent::MouseButtonRelease ||
+               type == QEvent::MouseButtonDblClick || type == QEvent::MouseMove;
+    }
+
+    static inline bool isKeyEvent(int type) {
+        return type == QEvent::KeyPress || type == QEvent::KeyRelease;
+    }
+
+    bool DockTrace::write(QIODevice *dev) const {
+        QDataStream out(dev);
+        out.setVersion(QDataStream::Qt_5_12);
+
+        out << traceMagic << traceVersion;
+        out << dockSize << horizontalSizes << verticalSizes;
+
+        out << quint32(toolWindows.size());
+        for (const auto &item : toolWindows) {
+            out << item.id << qint8(edge2index(item.edge)) << qint8(item.side)
+                << qint8(item.viewMode) << item.visible;
+        }
+
+        out << targets;
+
+        out << quint32(events.size());
+        for (const auto &e : events) {
+            out << e.time << e.type << e.target << qint16(e.pos.x()) << qint16(e.pos.y())
+                << e.modifiers;
+            if (isMouseEvent(e.type)) {
+                out << e.button << e.buttons;
+            } else {
+                out << e.key << e.text << e.autoRepeat;
+            }
+        }
+        return out.status() == QDataStream::Ok;
+    }
+
+    // Fails on anything the writer would not produce, values index arrays when replayed
+    bool DockTrace::read(QIODevice *dev) {
+        QDataStream in(dev);
+        in.setVersion(QDataStream::Qt_5_12);
+
+        quint32 magic;
+        quint16 version;
+        in >> magic >> version;
+        if (magic != traceMagic || version != traceVersion)
+            return false;
+
+        in >> dockSize >> horizontalSizes >> verticalSizes;
+
+        quint32 count;
+        in >> count;
+        toolWindows.clear();
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            ToolWindow item;
+            qint8 edge, side, viewMode;
+            in >> item.id >> edge >> side >> viewMode >> item.visible;
+            if (edge < 0 || edge > 3 || (side != Front && side != Back) || viewMode < DockPinned ||
+                viewMode > Undocked)
+                return false;
+            item.edge = index2edge(edge);
+            item.side = Side(side);
+            item.viewMode = ViewMode(viewMode);
+            toolWindows.append(item);
+        }
+
+        in >> targets;
+
+        in >> count;
+        events.clear();
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            DockTraceEvent e;
+            qint16 x, y;
+            in >> e.time >> e.type >> e.target >> x >> y >> e.modifiers;
+            if (in.status() != QDataStream::Ok)
+                break;
+            if (e.target >= targets.size() || (!isMouseEvent(e.type) && !isKeyEvent(e.type)))
+                return false;
+            e.pos = QPoint(x, y);
+            if (isMouseEvent(e.type)) {
+                in >> e.button >> e.buttons;
+            } else {
+                in >> e.key >> e.text >> e.autoRepeat;
+            }
+            events.append(e);
+        }
+        return in.status() == QDataStream::Ok;
+    }
+
+    QString toolWindowKey(const DockWidget *dock, QAbstractButton *button) {
+        auto d = DockWidgetPrivate::get(dock);
+        const auto &data = d->buttonData(button);
+        if (!data.id.isEmpty())
+            return data.id;
+
+        int edgeIdx = edge2index(data.edge);
+        auto bar = d->bars[edgeIdx];
+        return QString("@%1:%2:%3")
+            .arg(edgeIdx)
+            .arg(int(data.side))
+            .arg(bar ? bar->indexOf(data.side, button) : -1);
+    }
+
+    QAbstractButton *toolWindowByKey(const DockWidget *dock, const QString &key) {
+        auto d = DockWidgetPrivate::get(dock);
+        if (!key.startsWith('@'))
+            return d->buttonsById().value(key);
+
+        auto parts = key.mid(1).split(':');
+        if (parts.size() != 3)
+            return nullptr;
+        auto bar = d->bars[qBound(0, parts.at(0).toInt(), 3)];
+        if (!bar)
+            return nullptr;
+        return bar->buttons(Side(parts.at(1).toInt())).value(parts.at(2).toInt());
+    }
+
+    DockInputRecorderPrivate::DockInputRecorderPrivate() {
+    }
+
+    DockInputRecorderPrivate::~DockInputRecorderPrivate() {
+    }
+
+    void DockInputRecorderPrivate::begin() {
+        trace = {};
+        trace.dockSize = dock->size();
+        trace.horizontalSizes = dock->orientationSizes(Qt::Horizontal);
+        trace.verticalSizes = dock->orientationSizes(Qt::Vertical);
+
+        auto d = DockWidgetPrivate::get(dock.data());
+        for (auto bar : d->bars) {
+            if (!bar)
+                continue;
+            for (auto side : {Front, Back}) {
+                for (auto button : bar->buttons(side)) {
+                    const auto &data = d->buttonData(button);
+                    trace.toolWindows.append({toolWindowKey(dock, button), data.edge, data.side,
+                                              data.viewMode, button->isChecked()});
+                }
+            }
+        }
+        clock.start();
+    }
+
+    QString DockInputRecorderPrivate::targetOf(QWidget *top) const {
+        if (top == dock->window())
+            return "dock";
+
+        // Drag labels, menus are parented to the buttons and never recorded
+        if (top->windowType() == Qt::Popup) {
+            return (top->parentWidget() == dock) ? "popup" : QString();
+        }
+
+        auto d = DockWidgetPrivate::get(dock.data());
+        for (auto it = d->buttonDataHash.constBegin(); it != d->buttonDataHash.constEnd(); ++it) {
+            if (it->widget && DockWidgetPrivate::detachedWindow(it.value()) == top)
+                return "tool:" + toolWindowKey(dock, it.key());
+        }
+        return {};
+    }
+
+    bool DockInputRecorderPrivate::eventFilter(QObject *obj, QEvent *event) {
+        int type = event->type();
+        if (!recording || !dock || !obj->isWindowType() ||
+            !(isMouseEvent(type) || isKeyEvent(type)))
+            return QObject::eventFilter(obj, event);
+
+        auto window = static_cast<QWindow *>(obj);
+        if (window != lastWindow) {
+            lastWindow = window;
+            lastWidget = nullptr;
+            for (auto w : QApplication::topLevelWidgets()) {
+                if (w->windowHandle() == window) {
+                    lastWidget = w;
+                    break;
+                }
+            }
+        }
+
+        auto top = lastWidget.data();
+        if (!top)
+            return QObject::eventFilter(obj, event);
+
+        DockTraceEvent e;
+        e.type = quint16(type);
+        if (isMouseEvent(type)) {
+            auto me = static_cast<QMouseEvent *>(event);
+            if ((me->button() | me->buttons()) & Qt::RightButton)
+                return QObject::eventFilter(obj, event);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+            e.pos = me->pos();
+#else
+            e.pos = me->position().toPoint();
+#endif
+            e.button = quint16(me->button());
+            e.buttons = quint16(me->buttons());
+            e.modifiers = quint32(me->modifiers());
+        } else {
+            auto ke = static_cast<QKeyEvent *>(event);
+            if (ke->key() == Qt::Key_Menu)
+                return QObject::eventFilter(obj, event);
+            e.key = ke->key();
+            e.text = ke->text();
+            e.autoRepeat = ke->isAutoRepeat();
+            e.modifiers = quint32(ke->modifiers());
+        }
+
+        auto target = targetOf(top);
+        if (target.isEmpty())
+            return QObject::eventFilter(obj, event);
+        if (target == "dock") {
+            e.pos = dock->mapFrom(top, e.pos);
+        }
+
+        if (!clock.isValid()) {
+            begin();
+        }
+        e.time = quint32(clock.elapsed());
+
+        int index = trace.targets.indexOf(target);
+        if (index < 0) {
+            index = trace.targets.size();
+            trace.targets.append(target);
+        }
+        e.target = quint16(index);
+        trace.events.append(e);
+
+        return QObject::eventFilter(obj, event);
+    }
+
+    DockInputRecorder::DockInputRecorder(DockWidget *dock, QObject *parent)
+        : QObject(parent), d_ptr(new DockInputRecorderPrivate()) {
+        Q_D(DockInputRecorder);
+        d->q_ptr = this;
+        d->dock = dock;
+    }
+
+    DockInputRecorder::~DockInputRecorder() {
+        stop();
+    }
+
+    void DockInputRecorder::start() {
+        Q_D(DockInputRecorder);
+        if (d->recording)
+            return;
+
+        // The arrangement is taken with the first event, once the dock has its size
+        d->trace = {};
+        d->clock.invalidate();
+        d->recording = true;
+        qApp->installEventFilter(d);
+    }
+
+    void DockInputRecorder::stop() {
+        Q_D(DockInputRecorder);
+        if (!d->recording)
+            return;
+        d->recording = false;
+        qApp->removeEventFilter(d);
+    }
+
+    bool DockInputRecorder::isRecording() const {
+        Q_D(const DockInputRecorder);
+        return d->recording;
+    }
+
+    int DockInputRecorder::eventCount() const {
+        Q_D(const DockInputRecorder);
+        return int(d->trace.events.size());
+    }
+
+    bool DockInputRecorder::save(const QString &fileName) const {
+        Q_D(const DockInputRecorder);
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        return d->trace.write(&file);
+    }
+
+    // Counts the frames painted while replaying
+    class FrameCounter : public QObject {
+    public:
+        int frames = 0;
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override {
+            if (event->type() == QEvent::UpdateRequest &&
+                (obj->isWindowType() ||
+                 (obj->isWidgetType() && static_cast<QWidget *>(obj)->isWindow()))) {
+                frames++;
+            }
+            return QObject::eventFilter(obj, event);
+        }
+    };
+
+    QWidget *DockInputReplayerPrivate::resolveTarget(DockWidget *dock, const QString &target) {
+        if (target == "dock")
+            return dock;
+        if (target == "popup")
+            return QApplication::activePopupWidget();
+        if (!target.startsWith("tool:"))
+            return nullptr;
+
+        auto button = toolWindowByKey(dock, target.mid(5));
+        if (!button)
+            return nullptr;
+        const auto &data = DockWidgetPrivate::get(dock)->buttonData(button);
+        if (!data.widget)
+            return nullptr;
+        auto window = DockWidgetPrivate::detachedWindow(data);
+        return window->isWindow() ? window : nullptr;
+    }
+
+    DockInputReplayer::DockInputReplayer() : d_ptr(new DockInputReplayerPrivate()) {
+    }
+
+    DockInputReplayer::~DockInputReplayer() {
+    }
+
+    bool DockInputReplayer::load(const QString &fileName) {
+        Q_D(DockInputReplayer);
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+        if (!d->trace.read(&file)) {
+            d->trace = {};
+            return false;
+        }
+        return true;
+    }
+
+    int DockInputReplayer::eventCount() const {
+        Q_D(const DockInputReplayer);
+        return int(d->trace.events.size());
+    }
+
+    QSize DockInputReplayer::dockSize() const {
+        Q_D(const DockInputReplayer);
+        return d->trace.dockSize;
+    }
+
+    DockLayout DockInputReplayer::layout() const {
+        Q_D(const DockInputReplayer);
+
+        QList<DockLayout::Item> items[8];
+        for (const auto &item : d->trace.toolWindows) {
+            items[edge2index(item.edge) * 2 + item.side].append(
+                {item.id, item.viewMode, item.visible});
+        }
+
+        DockLayout res;
+        for (int i = 0; i < 8; ++i) {
+            res.setItems(index2edge(i / 2), Side(i % 2), items[i]);
+        }
+        res.setOrientationSizes(Qt::Horizontal, d->trace.horizontalSizes);
+        res.setOrientationSizes(Qt::Vertical, d->trace.verticalSizes);
+        return res;
+    }
+
+    DockInputReplayer::Report DockInputReplayer::replay(DockWidget *dock, Speed speed) const {
+        Q_D(const DockInputReplayer);
+
+        Report report;
+        report.samples.reserve(d->trace.events.size());
+
+        FrameCounter counter;
+        qApp->installEventFilter(&counter);
+
+        QElapsedTimer clock;
+        clock.start();
+        for (const auto &e : std::as_const(d->trace.events)) {
+            if (speed == RecordedSpeed) {
+                auto wait = qint64(e.time) - clock.elapsed();
+                if (wait > 0) {
+                    QEventLoop loop;
+                    QTimer::singleShot(int(wait), &loop, &QEventLoop::quit);
+                    loop.exec();
+                }
+            }
+            QCoreApplication::processEvents();
+
+            const auto &target = d->trace.targets.value(e.target);
+            auto w = DockInputReplayerPrivate::resolveTarget(dock, target);
+            auto top = w ? w->window() : nullptr;
+            auto window = top ? top->windowHandle() : nullptr;
+            if (!window || !top->isVisible()) {
+                report.skipped++;
+                continue;
+            }
+
+            // Delivered to the window like platform input, grabs and popups apply
+            auto windowPos = w->mapTo(top, e.pos);
+            auto globalPos = top->mapToGlobal(windowPos);
+
+            QElapsedTimer timer;
+            if (isMouseEvent(e.type)) {
+                QCursor::setPos(globalPos);
+                QMouseEvent event(QEvent::Type(e.type), windowPos, windowPos, globalPos,
+                                  Qt::MouseButton(e.button), Qt::MouseButtons(e.buttons),
+                                  Qt::KeyboardModifiers(e.modifiers));
+                timer.start();
+                QCoreApplication::sendEvent(window, &event);
+            } else {
+                QKeyEvent event(QEvent::Type(e.type), e.key, Qt::KeyboardModifiers(e.modifiers),
+                                e.text, e.autoRepeat);
+                timer.start();
+                QCoreApplication::sendEvent(window, &event);
+            }
+            report.samples.append({QEvent::Type(e.type), target, timer.nsecsElapsed() / 1000});
+            report.events++;
+        }
+        QCoreApplication::processEvents();
+
+        report.elapsed = clock.nsecsElapsed() / 1000;
+        report.frames = counter.frames;
+        return report;
+    }
+
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKINPUTTRACE_H
+#define DOCKINPUTTRACE_H
+
+#include <QtCore/QEvent>
+#include <QtCore/QObject>
+#include <QtCore/QSize>
+
+#include <JetBrainsDockingSystem/docklayout.h>
+
+namespace JBDS {
+
+    class DockWidget;
+
+    class DockInputRecorderPrivate;
+
+    // Records the mouse and key input reaching the windows of a dock: the window holding it,
+    // its floating tool windows and its drag popups. Tool windows are referred to by id, or
+    // by their place on the bars when they have none. Right clicks are left out, the menus
+    // they open run modal loops that cannot be replayed.
+    class JBDS_EXPORT DockInputRecorder : public QObject {
+        Q_OBJECT
+        Q_DECLARE_PRIVATE(DockInputRecorder)
+    public:
+        explicit DockInputRecorder(DockWidget *dock, QObject *parent = nullptr);
+        ~DockInputRecorder();
+
+        void start();
+        void stop();
+        bool isRecording() const;
+        int eventCount() const;
+
+        bool save(const QString &fileName) const;
+
+    protected:
+        QScopedPointer<DockInputRecorderPrivate> d_ptr;
+    };
+
+    class DockInputReplayerPrivate;
+
+    class JBDS_EXPORT DockInputReplayer {
+        Q_DECLARE_PRIVATE(DockInputReplayer)
+    public:
+        DockInputReplayer();
+        ~DockInputReplayer();
+
+        enum Speed {
+            RecordedSpeed, // Waits between events as long as the user did
+            MaximumSpeed,  // Only processes the pending events between two inputs
+        };
+
+        struct Sample {
+            QEvent::Type type;
+            QString target;
+            qint64 usecs; // Delivery of the event to its window
+        };
+
+        struct Report {
+            int events = 0;
+            int skipped = 0; // Targets missing from the dock
+            int frames = 0;  // Update requests of top level windows
+            qint64 elapsed = 0; // Microseconds
+            QList<Sample> samples;
+        };
+
+        bool load(const QString &fileName);
+        int eventCount() const;
+
+        // Size and arrangement of the dock when the first event was recorded, a dock
+        // rebuilt from them replays the trace like the recorded one
+        QSize dockSize() const;
+        DockLayout layout() const;
+
+        Report replay(DockWidget *dock, Speed speed = MaximumSpeed) const;
+
+    protected:
+        QScopedPointer<DockInputReplayerPrivate> d_ptr;
+
+        Q_DISABLE_COPY(DockInputReplayer)
+    };
+
+}
+
+#endif // DOCKINPUTTRACE_H
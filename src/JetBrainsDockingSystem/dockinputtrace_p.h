@@ -0,0 +1,100 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKINPUTTRACE_P_H
+#define DOCKINPUTTRACE_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
+#include <QtCore/QIODevice>
+#include <QtGui/QWindow>
+
+#include <JetBrainsDockingSystem/dockinputtrace.h>
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+namespace JBDS {
+
+    struct DockTraceEvent {
+        quint32 time = 0; // Milliseconds since the first event
+        quint16 type = 0;
+        quint16 target = 0; // Index in DockTrace::targets
+        QPoint pos;         // Local to the target
+        quint16 button = 0;
+        quint16 buttons = 0;
+        quint32 modifiers = 0;
+
+        // Key events only
+        qint32 key = 0;
+        QString text;
+        bool autoRepeat = false;
+    };
+
+    // Stream layout, version 1:
+    //   magic, version, dock size, splitter sizes, tool windows, targets, events
+    struct DockTrace {
+        struct ToolWindow {
+            QString id;
+            Qt::Edge edge = Qt::LeftEdge;
+            Side side = Front;
+            ViewMode viewMode = DockPinned;
+            bool visible = false;
+        };
+
+        QSize dockSize;
+        QList<int> horizontalSizes;
+        QList<int> verticalSizes;
+        QList<ToolWindow> toolWindows;
+        QStringList targets; // "dock", "popup" or "tool:<id>"
+        QList<DockTraceEvent> events;
+
+        bool write(QIODevice *dev) const;
+        bool read(QIODevice *dev);
+    };
+
+    class DockInputRecorderPrivate : public QObject {
+        Q_DECLARE_PUBLIC(DockInputRecorder)
+    public:
+        DockInputRecorderPrivate();
+        ~DockInputRecorderPrivate();
+
+        DockInputRecorder *q_ptr;
+
+        QPointer<DockWidget> dock;
+        bool recording = false;
+        DockTrace trace;
+        QElapsedTimer clock;
+
+        // Last window resolved to a top level widget, mouse moves come in bursts
+        QPointer<QWindow> lastWindow;
+        QPointer<QWidget> lastWidget;
+
+        void begin();
+        QString targetOf(QWidget *top) const;
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+    };
+
+    class DockInputReplayerPrivate {
+    public:
+        DockTrace trace;
+
+        static QWidget *resolveTarget(DockWidget *dock, const QString &target);
+    };
+
+    // Key of a tool window in traces, its id or its place on the bars
+    QString toolWindowKey(const DockWidget *dock, QAbstractButton *button);
+    QAbstractButton *toolWindowByKey(const DockWidget *dock, const QString &key);
+
+}
+
+#endif // DOCKINPUTTRACE_P_H
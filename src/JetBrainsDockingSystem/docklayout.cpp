@@ -0,0 +1,209 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "docklayout.h"
+#include "docklayout_p.h"
+
+#include <algorithm>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+namespace JBDS {
+
+    static const Qt::Edge layoutEdges[] = {
+        Qt::LeftEdge,
+        Qt::TopEdge,
+        Qt::RightEdge,
+        Qt::BottomEdge,
+    };
+
+    DockLayout::DockLayout() {
+    }
+
+    DockLayout::~DockLayout() {
+    }
+
+    QList<DockLayout::Item> DockLayout::items(Qt::Edge edge, Side side) const {
+        return m_items[layoutIndex(edge, side)];
+    }
+
+    void DockLayout::setItems(Qt::Edge edge, Side side, const QList<Item> &items) {
+        m_items[layoutIndex(edge, side)] = items;
+    }
+
+    QList<int> DockLayout::orientationSizes(Qt::Orientation orientation) const {
+        return orientation == Qt::Horizontal ? m_horizontalSizes : m_verticalSizes;
+    }
+
+    void DockLayout::setOrientationSizes(Qt::Orientation orientation, const QList<int> &sizes) {
+        (orientation == Qt::Horizontal ? m_horizontalSizes : m_verticalSizes) = sizes;
+    }
+
+    QStringList DockLayout::recentIds() const {
+        return m_recentIds;
+    }
+
+    void DockLayout::setRecentIds(const QStringList &ids) {
+        m_recentIds = ids;
+    }
+
+    bool DockLayout::isEmpty() const {
+        for (const auto &items : m_items) {
+            if (!items.isEmpty())
+                return false;
+        }
+        return m_horizontalSizes.isEmpty() && m_verticalSizes.isEmpty() && m_recentIds.isEmpty();
+    }
+
+    bool DockLayout::operator==(const DockLayout &other) const {
+        for (int i = 0; i < 8; ++i) {
+            if (m_items[i] != other.m_items[i])
+                return false;
+        }
+        return m_horizontalSizes == other.m_horizontalSizes &&
+               m_verticalSizes == other.m_verticalSizes && m_recentIds == other.m_recentIds;
+    }
+
+    // Returns a mask of the elements forming the longest strictly increasing subsequence
+    static QVector<bool> longestIncreasingMask(const QVector<int> &values) {
+        int n = values.size();
+        QVector<int> tails;    // tails[k]: index of the smallest tail of a run of length k + 1
+        QVector<int> prev(n, -1);
+        tails.reserve(n);
+
+        for (int i = 0; i < n; ++i) {
+            auto it = std::lower_bound(tails.begin(), tails.end(), values[i],
+                                       [&values](int idx, int v) { return values[idx] < v; });
+            int pos = int(it - tails.begin());
+            if (pos > 0)
+                prev[i] = tails[pos - 1];
+            if (pos == tails.size()) {
+                tails.append(i);
+            } else {
+                tails[pos] = i;
+            }
+        }
+
+        QVector<bool> mask(n, false);
+        for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = prev[i]) {
+            mask[i] = true;
+        }
+        return mask;
+    }
+
+    QList<DockLayoutOperation> diffLayouts(const DockLayout &from, const DockLayout &to) {
+        struct Placement {
+            int list;
+            int index;
+            DockLayout::Item item;
+        };
+
+        // Index the current placement of every identifiable tool window
+        QHash<QString, Placement> current;
+        for (int i = 0; i < 8; ++i) {
+            auto items = from.items(layoutEdges[i / 2], Side(i % 2));
+            for (int j = 0; j < items.size(); ++j) {
+                const auto &item = items.at(j);
+                if (item.id.isEmpty() || current.contains(item.id))
+                    continue;
+                current.insert(item.id, {i, j, item});
+            }
+        }
+
+        // Build the final order of each list, unknown and repeated ids are dropped
+        QList<DockLayout::Item> targets[8];
+        QSet<QString> mentioned;
+        for (int i = 0; i < 8; ++i) {
+            const auto &items = to.items(layoutEdges[i / 2], Side(i % 2));
+            for (const auto &item : items) {
+                if (!current.contains(item.id) || mentioned.contains(item.id))
+                    continue;
+                mentioned.insert(item.id);
+                targets[i].append(item);
+            }
+        }
+        for (int i = 0; i < 8; ++i) {
+            const auto &items = from.items(layoutEdges[i / 2], Side(i % 2));
+            for (const auto &item : items) {
+                if (item.id.isEmpty() || mentioned.contains(item.id))
+                    continue;
+                targets[i].append(current.value(item.id).item);
+            }
+        }
+
+        QList<DockLayoutOperation> hides;
+        QList<DockLayoutOperation> moves;
+        QList<DockLayoutOperation> viewModes;
+        QList<DockLayoutOperation> shows;
+
+        for (int i = 0; i < 8; ++i) {
+            const auto &target = targets[i];
+
+            // Tool windows already in this list and in increasing order stay where they are
+            QVector<int> stayers;
+            QVector<int> stayerPositions;
+            for (int p = 0; p < target.size(); ++p) {
+                const auto &placement = current.value(target.at(p).id);
+                if (placement.list == i) {
+                    stayers.append(placement.index);
+                    stayerPositions.append(p);
+                }
+            }
+            QVector<bool> anchored(target.size(), false);
+            auto mask = longestIncreasingMask(stayers);
+            for (int k = 0; k < mask.size(); ++k) {
+                if (mask[k])
+                    anchored[stayerPositions[k]] = true;
+            }
+
+            for (int p = 0; p < target.size(); ++p) {
+                const auto &item = target.at(p);
+                const auto &org = current.value(item.id).item;
+
+                if (!anchored[p]) {
+                    DockLayoutOperation op;
+                    op.type = DockLayoutOperation::Move;
+                    op.id = item.id;
+                    op.edge = layoutEdges[i / 2];
+                    op.side = Side(i % 2);
+                    if (p > 0)
+                        op.afterId = target.at(p - 1).id;
+                    moves.append(op);
+                }
+
+                if (org.viewMode != item.viewMode) {
+                    DockLayoutOperation op;
+                    op.type = DockLayoutOperation::SetViewMode;
+                    op.id = item.id;
+                    op.viewMode = item.viewMode;
+                    viewModes.append(op);
+                }
+
+                if (org.visible != item.visible) {
+                    DockLayoutOperation op;
+                    op.type = item.visible ? DockLayoutOperation::Show : DockLayoutOperation::Hide;
+                    op.id = item.id;
+                    (item.visible ? shows : hides).append(op);
+                }
+            }
+        }
+
+        QList<DockLayoutOperation> res;
+        res.reserve(hides.size() + moves.size() + viewModes.size() + shows.size() + 2);
+        res << hides << moves << viewModes << shows;
+
+        for (auto orientation : {Qt::Horizontal, Qt::Vertical}) {
+            auto sizes = to.orientationSizes(orientation);
+            if (sizes.isEmpty() || sizes == from.orientationSizes(orientation))
+                continue;
+            DockLayoutOperation op;
+            op.type = DockLayoutOperation::SetSizes;
+            op.orientation = orientation;
+            op.sizes = sizes;
+            res.append(op);
+        }
+        return res;
+    }
+
+}
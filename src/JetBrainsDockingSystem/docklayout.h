@@ -0,0 +1,65 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKLAYOUT_H
+#define DOCKLAYOUT_H
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <JetBrainsDockingSystem/jbdsnamespace.h>
+
+namespace JBDS {
+
+    // Plain data description of a dock arrangement. Tool windows are identified by the
+    // object name of their content widget, like QMainWindow::saveState() does. The id is
+    // taken when the tool window is inserted, or given with its factory, and is fixed from
+    // then on: renaming the content later has no effect, it must be inserted again.
+    class JBDS_EXPORT DockLayout {
+    public:
+        struct Item {
+            QString id;
+            ViewMode viewMode = DockPinned;
+            bool visible = false;
+
+            inline bool operator==(const Item &other) const {
+                return id == other.id && viewMode == other.viewMode && visible == other.visible;
+            }
+            inline bool operator!=(const Item &other) const {
+                return !(*this == other);
+            }
+        };
+
+        DockLayout();
+        ~DockLayout();
+
+        QList<Item> items(Qt::Edge edge, Side side) const;
+        void setItems(Qt::Edge edge, Side side, const QList<Item> &items);
+
+        // An empty list leaves the corresponding splitter untouched when applied
+        QList<int> orientationSizes(Qt::Orientation orientation) const;
+        void setOrientationSizes(Qt::Orientation orientation, const QList<int> &sizes);
+
+        // Activation history, most recent first. Listed tool windows go before the others
+        // when applied, an empty list leaves the history untouched.
+        QStringList recentIds() const;
+        void setRecentIds(const QStringList &ids);
+
+        bool isEmpty() const;
+
+        bool operator==(const DockLayout &other) const;
+        inline bool operator!=(const DockLayout &other) const {
+            return !(*this == other);
+        }
+
+    protected:
+        QList<Item> m_items[8];
+        QList<int> m_horizontalSizes;
+        QList<int> m_verticalSizes;
+        QStringList m_recentIds;
+    };
+
+}
+
+#endif // DOCKLAYOUT_H
@@ -0,0 +1,69 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKLAYOUT_P_H
+#define DOCKLAYOUT_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <JetBrainsDockingSystem/docklayout.h>
+
+namespace JBDS {
+
+    struct DockLayoutOperation {
+        enum Type {
+            Hide,
+            Move,
+            SetViewMode,
+            Show,
+            SetSizes,
+        };
+
+        Type type = Move;
+        QString id;
+
+        // Move: place the tool window right after `afterId` (at front if empty)
+        Qt::Edge edge = Qt::LeftEdge;
+        Side side = Front;
+        QString afterId;
+
+        ViewMode viewMode = DockPinned;
+
+        Qt::Orientation orientation = Qt::Horizontal;
+        QList<int> sizes;
+    };
+
+    inline int layoutIndex(Qt::Edge edge, Side side) {
+        int res = 0;
+        switch (edge) {
+            case Qt::TopEdge:
+                res = 1;
+                break;
+            case Qt::RightEdge:
+                res = 2;
+                break;
+            case Qt::BottomEdge:
+                res = 3;
+                break;
+            default:
+                break;
+        }
+        return res * 2 + side;
+    }
+
+    // Computes the shortest edit script that turns `from` into `to`. Tool windows that are
+    // absent from `to` keep their placement and are kept after the listed ones. Operations
+    // are ordered so that they can be applied one after another: hides first, then moves,
+    // view modes, shows and finally sizes.
+    QList<DockLayoutOperation> diffLayouts(const DockLayout &from, const DockLayout &to);
+
+}
+
+#endif // DOCKLAYOUT_P_H
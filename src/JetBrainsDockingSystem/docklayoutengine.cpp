@@ -0,0 +1,135 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "docklayoutengine_p.h"
+
+namespace JBDS {
+
+    static inline int panelSize(const DockLayoutEngine::Panel &panel) {
+        if (!panel.visible)
+            return 0;
+        return qBound(panel.minimum, panel.size, qMax(panel.minimum, panel.maximum));
+    }
+
+    void DockLayoutEngine::solveSplitter(int length, int handleWidth, const Panel &front,
+                                         const Panel &back, int middleMinimum, int priority,
+                                         int out[3]) {
+        int handles = int(front.visible) + int(back.visible);
+        int available = qMax(0, length - handles * handleWidth);
+
+        int sizes[2] = {panelSize(front), panelSize(back)};
+        const Panel *panels[2] = {&front, &back};
+
+        // The priority panel gives way first, then the front one
+        int order[2] = {0, 1};
+        if (priority == 1) {
+            order[0] = 1;
+            order[1] = 0;
+        }
+
+        // Shrink panels down to their minimums so that the middle fits
+        int deficit = middleMinimum - (available - sizes[0] - sizes[1]);
+        for (int i : order) {
+            if (deficit <= 0)
+                break;
+            if (!panels[i]->visible)
+                continue;
+            int delta = qMin(deficit, qMax(0, sizes[i] - panels[i]->minimum));
+            sizes[i] -= delta;
+            deficit -= delta;
+        }
+
+        // Over-constrained, panels have to go below their minimums
+        int overflow = sizes[0] + sizes[1] - available;
+        for (int i : order) {
+            if (overflow <= 0)
+                break;
+            int delta = qMin(overflow, sizes[i]);
+            sizes[i] -= delta;
+            overflow -= delta;
+        }
+
+        // QSplitter remembers the sizes of hidden children, keep the requests for them
+        out[0] = front.visible ? sizes[0] : qMax(0, front.size);
+        out[1] = available - sizes[0] - sizes[1];
+        out[2] = back.visible ? sizes[1] : qMax(0, back.size);
+    }
+
+    DockLayoutEngine::Result DockLayoutEngine::compute(const Input &input) {
+        Result res;
+
+        const int width = input.size.width();
+        const int height = input.size.height();
+        const int left = input.barExtents[0];
+        const int top = input.barExtents[1];
+        const int right = input.barExtents[2];
+        const int bottom = input.barExtents[3];
+        const int innerWidth = qMax(0, width - left - right);
+        const int innerHeight = qMax(0, height - top - bottom);
+
+        /*
+         *   0   1   2
+         * 0   t t t
+         *   l · · · r
+         *
+         * 1 l · * · r
+         *
+         *   l · · · r
+         * 2   b b b
+         *
+         */
+        if (left > 0)
+            res.bars[0] = QRect(0, top, left, innerHeight);
+        if (top > 0)
+            res.bars[1] = QRect(left, 0, innerWidth, top);
+        if (right > 0)
+            res.bars[2] = QRect(width - right, top, right, innerHeight);
+        if (bottom > 0)
+            res.bars[3] = QRect(left, height - bottom, innerWidth, bottom);
+
+        const auto &panels = input.panels;
+
+        // The horizontal splitter is as tall as the tallest minimum of its children
+        int middleMinimum = input.centralMinimum.height();
+        for (int i : {0, 2}) {
+            if (panels[i].visible)
+                middleMinimum = qMax(middleMinimum, panels[i].crossMinimum);
+        }
+        solveSplitter(innerHeight, input.handleWidth, panels[1], panels[3], middleMinimum,
+                      input.priority == 1 ? 0 : (input.priority == 3 ? 1 : -1),
+                      res.verticalSizes);
+        solveSplitter(innerWidth, input.handleWidth, panels[0], panels[2],
+                      input.centralMinimum.width(),
+                      input.priority == 0 ? 0 : (input.priority == 2 ? 1 : -1),
+                      res.horizontalSizes);
+
+        const auto &vs = res.verticalSizes;
+        const auto &hs = res.horizontalSizes;
+
+        int y = top;
+        if (panels[1].visible) {
+            res.panels[1] = QRect(left, y, innerWidth, vs[0]);
+            y += vs[0] + input.handleWidth;
+        }
+        const int middleY = y;
+        y += vs[1];
+        if (panels[3].visible) {
+            y += input.handleWidth;
+            res.panels[3] = QRect(left, y, innerWidth, vs[2]);
+        }
+
+        int x = left;
+        if (panels[0].visible) {
+            res.panels[0] = QRect(x, middleY, hs[0], vs[1]);
+            x += hs[0] + input.handleWidth;
+        }
+        res.central = QRect(x, middleY, hs[1], vs[1]);
+        x += hs[1];
+        if (panels[2].visible) {
+            x += input.handleWidth;
+            res.panels[2] = QRect(x, middleY, hs[2], vs[1]);
+        }
+        return res;
+    }
+
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKLAYOUTENGINE_P_H
+#define DOCKLAYOUTENGINE_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QRect>
+#include <QtCore/QSize>
+
+namespace JBDS {
+
+    // Widget-free model of the dock geometry. All arrays are indexed like `edge2index`:
+    // left, top, right, bottom.
+    class DockLayoutEngine {
+    public:
+        enum {
+            Unbounded = (1 << 24) - 1, // Same as QWIDGETSIZE_MAX
+        };
+
+        struct Panel {
+            bool visible = false;
+            int minimum = 0; // Along the splitter orientation
+            int maximum = Unbounded;
+            int size = 0; // Requested size
+            int crossMinimum = 0;
+        };
+
+        struct Input {
+            QSize size;
+            int barExtents[4] = {};
+            Panel panels[4];
+            QSize centralMinimum;
+            int handleWidth = 0;
+
+            // Index of the panel that gives way first when space runs out, -1 for none
+            int priority = -1;
+        };
+
+        struct Result {
+            QRect bars[4];
+            QRect panels[4];
+            QRect central;
+
+            // Ready to be passed to the dock splitters
+            int horizontalSizes[3] = {};
+            int verticalSizes[3] = {};
+        };
+
+        static Result compute(const Input &input);
+
+        // Solves one splitter holding `front`, a stretching middle and `back`.
+        // `priority` is 0 for front, 1 for back, -1 for none.
+        static void solveSplitter(int length, int handleWidth, const Panel &front,
+                                  const Panel &back, int middleMinimum, int priority,
+                                  int out[3]);
+    };
+
+}
+
+#endif // DOCKLAYOUTENGINE_P_H
@@ -0,0 +1,116 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "dockwidget.h"
+#include "dockwidget_p.h"
+
+#include <private/qwidget_p.h>
+
+namespace JBDS {
+
+    // An object with its private data, what it allocates on its own is not known here
+    static qint64 objectBytes(const QObject *obj) {
+        if (obj->isWidgetType())
+            return sizeof(QWidget) + sizeof(QWidgetPrivate);
+        return sizeof(QObject) + sizeof(QObjectPrivate);
+    }
+
+    static qint64 pixmapBytes(const QPixmap &pixmap) {
+        return qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    }
+
+    // Raster backing store of a window that has a native window, 32 bits per pixel
+    static qint64 backingStoreBytes(const QWidget *w) {
+        if (!w->isWindow() || !w->testAttribute(Qt::WA_WState_Created))
+            return 0;
+        auto size = QSizeF(w->size()) * w->devicePixelRatioF();
+        return qint64(size.width()) * qint64(size.height()) * 4;
+    }
+
+    static void addContent(const QObject *obj, DockWidget::MemoryUsage &usage) {
+        usage.objects++;
+        if (obj->isWidgetType()) {
+            usage.widgets++;
+        }
+        usage.contentBytes += objectBytes(obj);
+        for (auto child : obj->children()) {
+            addContent(child, usage);
+        }
+    }
+
+    // Stops at the content, which may live inside the container or a host
+    static void addLibrary(const QObject *obj, const QObject *content,
+                           DockWidget::MemoryUsage &usage) {
+        if (obj == content)
+            return;
+        usage.libraryBytes += objectBytes(obj);
+        if (auto snapshot = qobject_cast<const DockContentSnapshot *>(obj)) {
+            usage.pixmapBytes += pixmapBytes(snapshot->pixmap());
+        }
+        for (auto child : obj->children()) {
+            addLibrary(child, content, usage);
+        }
+    }
+
+    DockWidget::MemoryUsage DockWidget::memoryUsage(const QAbstractButton *button) const {
+        Q_D(const DockWidget);
+        MemoryUsage usage;
+
+        auto it = d->buttonDataHash.constFind(const_cast<QAbstractButton *>(button));
+        if (it == d->buttonDataHash.constEnd())
+            return usage;
+
+        const auto &data = it.value();
+        auto w = data.widget;
+        if (w) {
+            addContent(w, usage);
+            usage.windowBytes += backingStoreBytes(w);
+        }
+        addLibrary(button, w, usage);
+        if (data.container) {
+            addLibrary(data.container, w, usage);
+        }
+        for (auto host : data.hosts) {
+            if (!host)
+                continue;
+            addLibrary(host, w, usage);
+            usage.windowBytes += backingStoreBytes(host);
+        }
+
+        // The record, its id and the entries of both hashes
+        usage.libraryBytes += sizeof(DockButtonData) + data.id.capacity() * sizeof(QChar) +
+                              4 * sizeof(void *);
+        return usage;
+    }
+
+    DockWidget::MemoryUsage DockWidget::memoryUsage() const {
+        Q_D(const DockWidget);
+        MemoryUsage usage;
+
+        for (auto it = d->buttonDataHash.constBegin(); it != d->buttonDataHash.constEnd(); ++it) {
+            auto item = memoryUsage(it.key());
+            usage.objects += item.objects;
+            usage.widgets += item.widgets;
+            usage.contentBytes += item.contentBytes;
+            usage.windowBytes += item.windowBytes;
+            usage.pixmapBytes += item.pixmapBytes;
+            usage.libraryBytes += item.libraryBytes;
+        }
+
+        // Pictures of the central widget while resizing or animating
+        const auto &central = d->centralContainer->findChildren<DockContentSnapshot *>(
+            QString(), Qt::FindDirectChildrenOnly);
+        for (auto snapshot : central) {
+            usage.pixmapBytes += pixmapBytes(snapshot->pixmap());
+        }
+
+        // Removed tool windows wait for their deferred deletion, anything left after it leaks.
+        // Window hosts are top level, they are tracked rather than looked for among children.
+        for (const auto &w : std::as_const(d->retiredWidgets)) {
+            if (w)
+                usage.orphans++;
+        }
+        return usage;
+    }
+
+}
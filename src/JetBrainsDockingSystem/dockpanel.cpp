@@ -2,10 +2,12 @@
 // SPDX-License-Identifier: MIT
 
 #include "dockpanel_p.h"
+#include "jbdsperf_p.h"
 
 namespace JBDS {
 
-    DockPanel::DockPanel(Qt::Orientation orient, QWidget *parent) : QSplitter(orient, parent) {
+    DockPanel::DockPanel(Qt::Orientation orient, QWidget *parent)
+        : DockSplitter(orient, parent) {
         setChildrenCollapsible(false);
 
         m_firstWidget = new QStackedWidget();
@@ -28,6 +30,7 @@ namespace JBDS {
     }
 
     int DockPanel::insertWidget(Side side, int index, QWidget *w, bool visible) {
+        JBDS_TRACE_SCOPE("DockPanel::insertWidget");
         auto container = (side == Front) ? m_firstWidget : m_secondWidget;
         int res = container->insertWidget(index, w);
         if (visible) {
@@ -41,6 +44,7 @@ namespace JBDS {
     }
 
     void DockPanel::removeWidget(Side side, QWidget *w) {
+        JBDS_TRACE_SCOPE("DockPanel::removeWidget");
         auto container = (side == Front) ? m_firstWidget : m_secondWidget;
         bool isCurrent = container->currentWidget() == w;
         container->removeWidget(w);
@@ -87,6 +91,7 @@ namespace JBDS {
     }
 
     void DockPanel::setContainerVisible(Side side, bool visible) {
+        JBDS_TRACE_SCOPE(visible ? "DockPanel::show" : "DockPanel::hide");
         auto container = (side == Front) ? m_firstWidget : m_secondWidget;
         container->setVisible(visible);
         if (visible) {
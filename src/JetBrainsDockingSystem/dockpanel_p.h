@@ -13,14 +13,14 @@
 // version without notice, or may even be removed.
 //
 
-#include <QtWidgets/QSplitter>
 #include <QtWidgets/QStackedWidget>
 
 #include <JetBrainsDockingSystem/dockwidget.h>
+#include <JetBrainsDockingSystem/docksplitter_p.h>
 
 namespace JBDS {
 
-    class DockPanel : public QSplitter {
+    class DockPanel : public DockSplitter {
         Q_OBJECT
     public:
         explicit DockPanel(Qt::Orientation orient, QWidget *parent = nullptr);
@@ -0,0 +1,238 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "dockprofiler.h"
+#include "dockprofiler_p.h"
+
+#include <algorithm>
+
+#include <QtCore/QTimer>
+#include <QtWidgets/QHeaderView>
+
+#include "dockwidget_p.h"
+#include "dockinputtrace_p.h"
+
+namespace JBDS {
+
+    static inline int costOf(int type) {
+        switch (type) {
+            case QEvent::Paint:
+                return DockProfiler::Paint;
+            case QEvent::LayoutRequest:
+                return DockProfiler::LayoutRequest;
+            case QEvent::Resize:
+                return DockProfiler::Resize;
+            case QEvent::Show:
+                return DockProfiler::Show;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    void DockCostSeries::add(qint64 nsecs) {
+        if (samples.size() < window) {
+            samples.append(nsecs);
+        } else {
+            samples[next] = nsecs;
+        }
+        next = (next + 1) % window;
+        count++;
+        total += nsecs;
+        max = qMax(max, nsecs);
+    }
+
+    DockProfiler::Stats DockCostSeries::stats() const {
+        DockProfiler::Stats res;
+        res.count = count;
+        res.total = total / 1000;
+        res.max = max / 1000;
+        if (samples.isEmpty())
+            return res;
+
+        auto sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        auto at = [&sorted](double p) {
+            return sorted.at(qMin(int(sorted.size()) - 1, int(sorted.size() * p))) / 1000;
+        };
+        res.p50 = at(0.5);
+        res.p90 = at(0.9);
+        res.p99 = at(0.99);
+        return res;
+    }
+
+    DockProfilerPrivate::DockProfilerPrivate() {
+    }
+
+    DockProfilerPrivate::~DockProfilerPrivate() {
+    }
+
+    void DockProfilerPrivate::record(QAbstractButton *button, DockProfiler::Cost cost,
+                                     qint64 nsecs) {
+        auto it = records.find(button);
+        if (it == records.end()) {
+            it = records.insert(button, QVector<DockCostSeries>(DockProfiler::CostCount));
+            connect(button, &QObject::destroyed, this, [this, button]() {
+                records.remove(button); //
+            });
+        }
+        (*it)[cost].add(nsecs);
+    }
+
+    void DockProfilerPrivate::toolWindowEvent(QAbstractButton *button, QEvent *event) {
+        // Events a tool window receives while handling its own are part of its span
+        int cost = costOf(event->type());
+        if (cost < 0 || (spanBegin >= 0 && spanButton == button))
+            return;
+
+        // The next tool window taking over ends the span, so does the return to the loop
+        endSpan();
+        spanButton = button;
+        spanCost = DockProfiler::Cost(cost);
+        spanBegin = clock.nsecsElapsed();
+        if (!spanEndPending) {
+            spanEndPending = true;
+            QMetaObject::invokeMethod(
+                this,
+                [this]() {
+                    spanEndPending = false;
+                    endSpan();
+                },
+                Qt::QueuedConnection);
+        }
+    }
+
+    void DockProfilerPrivate::endSpan() {
+        if (spanBegin < 0)
+            return;
+        auto elapsed = clock.nsecsElapsed() - spanBegin;
+        spanBegin = -1;
+
+        // Deleted meanwhile
+        if (spanButton) {
+            record(spanButton, spanCost, elapsed);
+        }
+    }
+
+    DockProfiler::DockProfiler(DockWidget *dock, QObject *parent)
+        : QObject(parent), d_ptr(new DockProfilerPrivate()) {
+        Q_D(DockProfiler);
+        d->q_ptr = this;
+        d->dock = dock;
+    }
+
+    DockProfiler::~DockProfiler() {
+        stop();
+    }
+
+    void DockProfiler::start() {
+        Q_D(DockProfiler);
+        if (d->running || !d->dock)
+            return;
+        d->running = true;
+        d->clock.start();
+        DockWidgetPrivate::get(d->dock.data())->profiler = d;
+    }
+
+    void DockProfiler::stop() {
+        Q_D(DockProfiler);
+        if (!d->running)
+            return;
+        d->running = false;
+        d->endSpan();
+        if (d->dock) {
+            auto dd = DockWidgetPrivate::get(d->dock.data());
+            if (dd->profiler == d) {
+                dd->profiler = nullptr;
+            }
+        }
+    }
+
+    bool DockProfiler::isRunning() const {
+        Q_D(const DockProfiler);
+        return d->running;
+    }
+
+    void DockProfiler::reset() {
+        Q_D(DockProfiler);
+        for (auto it = d->records.begin(); it != d->records.end(); ++it) {
+            it.value() = QVector<DockCostSeries>(CostCount);
+        }
+    }
+
+    QList<DockProfiler::Entry> DockProfiler::report() const {
+        Q_D(const DockProfiler);
+        QList<Entry> res;
+        if (!d->dock)
+            return res;
+
+        auto dd = DockWidgetPrivate::get(d->dock.data());
+        for (auto it = d->records.constBegin(); it != d->records.constEnd(); ++it) {
+            // Removed from the dock but not deleted yet
+            if (!dd->buttonDataHash.contains(it.key()))
+                continue;
+
+            Entry entry;
+            entry.button = it.key();
+            entry.key = toolWindowKey(d->dock, it.key());
+            for (int i = 0; i < CostCount; ++i) {
+                entry.costs[i] = it.value().at(i).stats();
+                entry.total += entry.costs[i].total;
+            }
+            res.append(entry);
+        }
+        std::sort(res.begin(), res.end(), [](const Entry &a, const Entry &b) {
+            return a.total > b.total; //
+        });
+        return res;
+    }
+
+    DockProfilerView::DockProfilerView(DockProfiler *profiler, QWidget *parent)
+        : QTreeWidget(parent), profiler(profiler) {
+        setRootIsDecorated(false);
+        setUniformRowHeights(true);
+        setHeaderLabels({tr("Tool window"), tr("Total (ms)"), tr("Paint p50/p99 (us)"),
+                         tr("Layout p50/p99 (us)"), tr("Resize p50/p99 (us)"),
+                         tr("Show p50/p99 (us)"), tr("Events")});
+        header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+        auto timer = new QTimer(this);
+        timer->setInterval(1000);
+        connect(timer, &QTimer::timeout, this, [this]() {
+            if (isVisible()) {
+                refresh();
+            }
+        });
+        timer->start();
+    }
+
+    DockProfilerView::~DockProfilerView() {
+    }
+
+    void DockProfilerView::refresh() {
+        clear();
+        if (!profiler)
+            return;
+
+        // Repaint the table once
+        setUpdatesEnabled(false);
+        for (const auto &entry : profiler->report()) {
+            auto item = new QTreeWidgetItem(this);
+            item->setText(0, entry.key);
+            item->setText(1, QString::number(entry.total / 1000.0, 'f', 1));
+
+            int events = 0;
+            for (int i = 0; i < DockProfiler::CostCount; ++i) {
+                const auto &stats = entry.costs[i];
+                item->setText(2 + i, QString("%1 / %2").arg(stats.p50).arg(stats.p99));
+                events += stats.count;
+            }
+            item->setText(2 + DockProfiler::CostCount, QString::number(events));
+            for (int i = 1; i < columnCount(); ++i) {
+                item->setTextAlignment(i, Qt::AlignRight | Qt::AlignVCenter);
+            }
+        }
+        setUpdatesEnabled(true);
+    }
+
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKPROFILER_H
+#define DOCKPROFILER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QTreeWidget>
+
+#include <JetBrainsDockingSystem/jbdsglobal.h>
+
+namespace JBDS {
+
+    class DockWidget;
+
+    class DockProfilerPrivate;
+
+    // Attributes the time spent in paint, layout request, resize and show events to the tool
+    // window whose content received them. Only runs between start() and stop(), and one
+    // profiler at a time on a dock.
+    //
+    // The events are seen by the filter the dock installs on each tool window. A span runs
+    // from such an event until another tool window receives one or control returns to the
+    // event loop, so it includes the children of the content and what the handler caused.
+    class JBDS_EXPORT DockProfiler : public QObject {
+        Q_OBJECT
+        Q_DECLARE_PRIVATE(DockProfiler)
+    public:
+        explicit DockProfiler(DockWidget *dock, QObject *parent = nullptr);
+        ~DockProfiler();
+
+        enum Cost {
+            Paint,
+            LayoutRequest,
+            Resize,
+            Show,
+            CostCount,
+        };
+
+        // Microseconds, the percentiles are over the latest 256 events
+        struct Stats {
+            int count = 0;
+            qint64 total = 0;
+            qint64 p50 = 0;
+            qint64 p90 = 0;
+            qint64 p99 = 0;
+            qint64 max = 0;
+        };
+
+        struct Entry {
+            QAbstractButton *button = nullptr;
+            QString key; // Id of the tool window, or its place on the bars
+            Stats costs[CostCount];
+            qint64 total = 0;
+        };
+
+        void start();
+        void stop();
+        bool isRunning() const;
+        void reset();
+
+        // Most expensive tool window first
+        QList<Entry> report() const;
+
+    protected:
+        QScopedPointer<DockProfilerPrivate> d_ptr;
+    };
+
+    // Table of the report of a profiler, refreshed every second while visible. Meant to be
+    // added to the dock it profiles as a tool window.
+    class JBDS_EXPORT DockProfilerView : public QTreeWidget {
+        Q_OBJECT
+    public:
+        explicit DockProfilerView(DockProfiler *profiler, QWidget *parent = nullptr);
+        ~DockProfilerView();
+
+        void refresh();
+
+    private:
+        QPointer<DockProfiler> profiler;
+    };
+
+}
+
+#endif // DOCKPROFILER_H
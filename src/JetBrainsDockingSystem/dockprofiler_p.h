@@ -0,0 +1,67 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKPROFILER_P_H
+#define DOCKPROFILER_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+
+#include <JetBrainsDockingSystem/dockprofiler.h>
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+namespace JBDS {
+
+    // Cumulative totals and a ring of the latest samples in nanoseconds
+    struct DockCostSeries {
+        static constexpr int window = 256;
+
+        QVector<qint64> samples;
+        int next = 0;
+        int count = 0;
+        qint64 total = 0;
+        qint64 max = 0;
+
+        void add(qint64 nsecs);
+        DockProfiler::Stats stats() const;
+    };
+
+    class DockProfilerPrivate : public QObject {
+        Q_DECLARE_PUBLIC(DockProfiler)
+    public:
+        DockProfilerPrivate();
+        ~DockProfilerPrivate();
+
+        DockProfiler *q_ptr;
+
+        QPointer<DockWidget> dock;
+        bool running = false;
+        QElapsedTimer clock;
+
+        // The span open since a tool window received an event, -1 for none
+        QPointer<QAbstractButton> spanButton;
+        DockProfiler::Cost spanCost = DockProfiler::Paint;
+        qint64 spanBegin = -1;
+        bool spanEndPending = false;
+
+        QHash<QAbstractButton *, QVector<DockCostSeries>> records;
+
+        void toolWindowEvent(QAbstractButton *button, QEvent *event);
+        void endSpan();
+        void record(QAbstractButton *button, DockProfiler::Cost cost, qint64 nsecs);
+    };
+
+}
+
+#endif // DOCKPROFILER_P_H
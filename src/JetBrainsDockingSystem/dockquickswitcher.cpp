@@ -0,0 +1,119 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "dockquickswitcher_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtGui/QtEvents>
+#include <QtWidgets/QVBoxLayout>
+
+#include "dockwidget_p.h"
+#include "jbdsperf_p.h"
+
+namespace JBDS {
+
+    DockQuickSwitcher::DockQuickSwitcher(DockWidgetPrivate *d, QWidget *parent)
+        : QFrame(parent, Qt::Popup), d(d) {
+        setObjectName("dock-quick-switcher");
+        setFrameShape(QFrame::StyledPanel);
+
+        m_edit = new QLineEdit();
+        m_edit->setObjectName("dock-quick-switcher-edit");
+        m_edit->setPlaceholderText(
+            QCoreApplication::translate("JetBrainsDockingSystem", "Search tool windows"));
+        m_edit->installEventFilter(this);
+
+        // The focus stays in the edit, keys moving the selection are forwarded
+        m_list = new QListWidget();
+        m_list->setObjectName("dock-quick-switcher-list");
+        m_list->setFocusPolicy(Qt::NoFocus);
+        m_list->setUniformItemSizes(true);
+
+        auto layout = new QVBoxLayout();
+        layout->setContentsMargins(4, 4, 4, 4);
+        layout->setSpacing(4);
+        layout->addWidget(m_edit);
+        layout->addWidget(m_list);
+        setLayout(layout);
+
+        connect(m_edit, &QLineEdit::textChanged, this, &DockQuickSwitcher::search);
+        connect(m_list, &QListWidget::itemClicked, this, [this](QListWidgetItem *item) {
+            activate(m_list->row(item)); //
+        });
+    }
+
+    DockQuickSwitcher::~DockQuickSwitcher() {
+    }
+
+    void DockQuickSwitcher::popup() {
+        auto q = d->q_ptr;
+
+        // Buttons on a hidden bar are not painted, their renames are picked up here
+        d->updateAppearances();
+
+        int w = qBound(200, q->width() - 40, 480);
+        resize(w, 320);
+        move(q->mapToGlobal(QPoint((q->width() - w) / 2, q->height() / 8)));
+
+        if (m_edit->text().isEmpty()) {
+            search();
+        } else {
+            m_edit->clear();
+        }
+        show();
+        m_edit->setFocus(Qt::PopupFocusReason);
+    }
+
+    bool DockQuickSwitcher::eventFilter(QObject *obj, QEvent *event) {
+        if (obj != m_edit || event->type() != QEvent::KeyPress)
+            return QFrame::eventFilter(obj, event);
+
+        auto e = static_cast<QKeyEvent *>(event);
+        switch (e->key()) {
+            case Qt::Key_Up:
+            case Qt::Key_Down:
+            case Qt::Key_PageUp:
+            case Qt::Key_PageDown:
+                QCoreApplication::sendEvent(m_list, event);
+                return true;
+            case Qt::Key_Return:
+            case Qt::Key_Enter:
+                activate(m_list->currentRow());
+                return true;
+            case Qt::Key_Escape:
+                hide();
+                return true;
+            default:
+                break;
+        }
+        return QFrame::eventFilter(obj, event);
+    }
+
+    void DockQuickSwitcher::search() {
+        JBDS_TRACE_SCOPE("DockQuickSwitcher::search");
+
+        m_buttons = d->searchIndex()->match(m_edit->text(), maxResults);
+
+        // Repaint the list once
+        m_list->setUpdatesEnabled(false);
+        m_list->clear();
+        for (auto button : std::as_const(m_buttons)) {
+            const auto &id = d->buttonData(button).id;
+            auto text = button->text();
+            auto item = new QListWidgetItem(button->icon(), text.isEmpty() ? id : text, m_list);
+            item->setToolTip(id);
+        }
+        m_list->setCurrentRow(0);
+        m_list->setUpdatesEnabled(true);
+    }
+
+    // Removed meanwhile if the dock does not know it anymore
+    void DockQuickSwitcher::activate(int row) {
+        auto button = m_buttons.value(row);
+        hide();
+        if (button && d->buttonDataHash.contains(button)) {
+            d->q_ptr->activateToolWindow(button);
+        }
+    }
+
+}
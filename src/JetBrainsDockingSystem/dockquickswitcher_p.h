@@ -0,0 +1,52 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKQUICKSWITCHER_P_H
+#define DOCKQUICKSWITCHER_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QFrame>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QListWidget>
+
+namespace JBDS {
+
+    class DockWidgetPrivate;
+
+    // Popup searching the tool windows as the user types, the matches are listed best first.
+    // Created on first use and shown again for every later one.
+    class DockQuickSwitcher : public QFrame {
+    public:
+        explicit DockQuickSwitcher(DockWidgetPrivate *d, QWidget *parent = nullptr);
+        ~DockQuickSwitcher();
+
+        static constexpr int maxResults = 50;
+
+        void popup();
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+
+    private:
+        DockWidgetPrivate *d;
+
+        QLineEdit *m_edit;
+        QListWidget *m_list;
+        QVector<QAbstractButton *> m_buttons; // Of the rows
+
+        void search();
+        void activate(int row);
+    };
+
+}
+
+#endif // DOCKQUICKSWITCHER_P_H
@@ -0,0 +1,132 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "dockrecentswitcher_p.h"
+
+#include <QtGui/QGuiApplication>
+#include <QtGui/QtEvents>
+#include <QtWidgets/QVBoxLayout>
+
+#include "dockwidget_p.h"
+
+namespace JBDS {
+
+    static const int visibleRows = 12;
+
+    DockRecentSwitcher::DockRecentSwitcher(DockWidgetPrivate *d, QWidget *parent)
+        : QFrame(parent, Qt::Popup), d(d) {
+        setObjectName("dock-recent-switcher");
+        setFrameShape(QFrame::StyledPanel);
+
+        m_list = new QListWidget();
+        m_list->setObjectName("dock-recent-switcher-list");
+        m_list->setUniformItemSizes(true);
+        m_list->installEventFilter(this);
+
+        auto layout = new QVBoxLayout();
+        layout->setContentsMargins(4, 4, 4, 4);
+        layout->addWidget(m_list);
+        setLayout(layout);
+
+        connect(m_list, &QListWidget::itemClicked, this, [this](QListWidgetItem *item) {
+            activate(m_list->row(item)); //
+        });
+    }
+
+    DockRecentSwitcher::~DockRecentSwitcher() {
+    }
+
+    void DockRecentSwitcher::popup(bool backward) {
+        auto q = d->q_ptr;
+
+        m_buttons.clear();
+        for (auto button = d->recentHead; button; button = d->buttonData(button).recentNext) {
+            m_buttons.append(button);
+        }
+        if (m_buttons.isEmpty())
+            return;
+
+        // Buttons on a hidden bar are not painted, their renames are picked up here
+        d->updateAppearances();
+
+        m_list->setUpdatesEnabled(false);
+        m_list->clear();
+        for (auto button : std::as_const(m_buttons)) {
+            const auto &id = d->buttonData(button).id;
+            auto text = button->text();
+            auto item = new QListWidgetItem(button->icon(), text.isEmpty() ? id : text, m_list);
+            item->setToolTip(id);
+        }
+
+        // The first row is the tool window in use, going back starts from the oldest
+        int count = m_buttons.size();
+        m_list->setCurrentRow(backward ? count - 1 : qMin(1, count - 1));
+        m_list->setUpdatesEnabled(true);
+
+        int rows = qMin(count, visibleRows);
+        int frame = m_list->frameWidth() * 2;
+        resize(320, m_list->sizeHintForRow(0) * rows + frame + 8);
+        move(q->mapToGlobal(QPoint((q->width() - width()) / 2, (q->height() - height()) / 2)));
+
+        m_holding = QGuiApplication::queryKeyboardModifiers() & Qt::ControlModifier;
+        show();
+        m_list->setFocus(Qt::PopupFocusReason);
+    }
+
+    bool DockRecentSwitcher::eventFilter(QObject *obj, QEvent *event) {
+        if (obj != m_list)
+            return QFrame::eventFilter(obj, event);
+
+        switch (event->type()) {
+            case QEvent::KeyPress: {
+                switch (static_cast<QKeyEvent *>(event)->key()) {
+                    case Qt::Key_Tab:
+                    case Qt::Key_Down:
+                        step(1);
+                        return true;
+                    case Qt::Key_Backtab:
+                    case Qt::Key_Up:
+                        step(-1);
+                        return true;
+                    case Qt::Key_Return:
+                    case Qt::Key_Enter:
+                        activate(m_list->currentRow());
+                        return true;
+                    case Qt::Key_Escape:
+                        hide();
+                        return true;
+                    default:
+                        break;
+                }
+                break;
+            }
+            case QEvent::KeyRelease: {
+                if (m_holding && static_cast<QKeyEvent *>(event)->key() == Qt::Key_Control) {
+                    activate(m_list->currentRow());
+                    return true;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return QFrame::eventFilter(obj, event);
+    }
+
+    void DockRecentSwitcher::step(int delta) {
+        int count = m_list->count();
+        if (count == 0)
+            return;
+        m_list->setCurrentRow((m_list->currentRow() + delta + count) % count);
+    }
+
+    // Removed meanwhile if the dock does not know it anymore
+    void DockRecentSwitcher::activate(int row) {
+        auto button = m_buttons.value(row);
+        hide();
+        if (button && d->buttonDataHash.contains(button)) {
+            d->q_ptr->activateToolWindow(button);
+        }
+    }
+
+}
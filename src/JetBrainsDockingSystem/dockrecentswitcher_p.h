@@ -0,0 +1,49 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKRECENTSWITCHER_P_H
+#define DOCKRECENTSWITCHER_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QFrame>
+#include <QtWidgets/QListWidget>
+
+namespace JBDS {
+
+    class DockWidgetPrivate;
+
+    // Popup listing the activation history, the selection starts on the tool window used
+    // before the current one. Created on first use and shown again for every later one.
+    class DockRecentSwitcher : public QFrame {
+    public:
+        explicit DockRecentSwitcher(DockWidgetPrivate *d, QWidget *parent = nullptr);
+        ~DockRecentSwitcher();
+
+        void popup(bool backward);
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+
+    private:
+        DockWidgetPrivate *d;
+
+        QListWidget *m_list;
+        QVector<QAbstractButton *> m_buttons; // Of the rows
+        bool m_holding = false;               // Opened with Ctrl held, releasing it chooses
+
+        void step(int delta);
+        void activate(int row);
+    };
+
+}
+
+#endif // DOCKRECENTSWITCHER_P_H
@@ -0,0 +1,148 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "docksearchindex_p.h"
+
+#include <algorithm>
+
+namespace JBDS {
+
+    void DockSearchIndex::insert(QAbstractButton *button, const QString &title,
+                                 const QString &id) {
+        Entry entry{button, {field(title), field(id)}};
+        auto it = m_slots.find(button);
+        if (it != m_slots.end()) {
+            m_entries[it.value()] = std::move(entry);
+        } else {
+            m_slots.insert(button, m_entries.size());
+            m_entries.append(std::move(entry));
+        }
+        m_lastValid = false;
+    }
+
+    // The last entry takes the place of the removed one
+    void DockSearchIndex::remove(QAbstractButton *button) {
+        auto it = m_slots.find(button);
+        if (it == m_slots.end())
+            return;
+
+        int slot = it.value();
+        m_slots.erase(it);
+        int last = m_entries.size() - 1;
+        if (slot != last) {
+            m_entries[slot] = std::move(m_entries[last]);
+            m_slots[m_entries.at(slot).button] = slot;
+        }
+        m_entries.removeLast();
+        m_lastValid = false;
+    }
+
+    const QVector<QAbstractButton *> &DockSearchIndex::match(const QString &pattern, int max) {
+        QString folded;
+        folded.reserve(pattern.size());
+        for (auto ch : pattern) {
+            if (!ch.isSpace())
+                folded.append(ch.toCaseFolded());
+        }
+
+        // A title match ranks before the same match in the id
+        m_scored.clear();
+        auto consider = [this, &folded](int i) {
+            const auto &entry = m_entries.at(i);
+            int best = score(entry.fields[0], folded);
+            int byId = score(entry.fields[1], folded);
+            if (byId >= 0) {
+                best = qMax(best, qMax(byId - 2, 0));
+            }
+            if (best >= 0) {
+                m_scored.append({best, i});
+            }
+        };
+        if (m_lastValid && folded.startsWith(m_lastPattern)) {
+            for (int i : std::as_const(m_lastHits)) {
+                consider(i);
+            }
+        } else {
+            for (int i = 0; i < m_entries.size(); ++i) {
+                consider(i);
+            }
+        }
+
+        m_lastPattern = folded;
+        m_lastValid = true;
+        m_lastHits.clear();
+        for (const auto &item : std::as_const(m_scored)) {
+            m_lastHits.append(item.second);
+        }
+
+        // Then the shortest title, the tightest match
+        auto better = [this](const QPair<int, int> &a, const QPair<int, int> &b) {
+            if (a.first != b.first)
+                return a.first > b.first;
+            const auto &x = m_entries.at(a.second).fields[0].text;
+            const auto &y = m_entries.at(b.second).fields[0].text;
+            if (x.size() != y.size())
+                return x.size() < y.size();
+            return x < y;
+        };
+        int count = int(m_scored.size());
+        if (max >= 0 && max < count) {
+            count = max;
+        }
+        std::partial_sort(m_scored.begin(), m_scored.begin() + count, m_scored.end(), better);
+
+        m_results.clear();
+        for (int i = 0; i < count; ++i) {
+            m_results.append(m_entries.at(m_scored.at(i).second).button);
+        }
+        return m_results;
+    }
+
+    // Words start after a separator, at an upper case letter following a lower case one and
+    // where digits begin or end
+    DockSearchIndex::Field DockSearchIndex::field(const QString &text) {
+        Field res;
+        res.text = text.toCaseFolded();
+        res.starts = QByteArray(res.text.size(), 0);
+        for (int i = 0; i < qMin(text.size(), res.text.size()); ++i) {
+            auto ch = text.at(i);
+            if (!ch.isLetterOrNumber())
+                continue;
+            if (i == 0) {
+                res.starts[i] = 1;
+                continue;
+            }
+            auto prev = text.at(i - 1);
+            res.starts[i] = !prev.isLetterOrNumber() || (ch.isUpper() && prev.isLower()) ||
+                            (ch.isDigit() != prev.isDigit());
+        }
+        return res;
+    }
+
+    // Greedy, each character of the pattern takes its first occurrence after the previous
+    // one. Word starts and runs score, gaps cost. -1 if the pattern is not a subsequence.
+    int DockSearchIndex::score(const Field &field, const QString &pattern) {
+        auto text = field.text.constData();
+        int size = field.text.size();
+        int res = 0;
+        int last = -1;
+        int pos = 0;
+        for (auto ch : pattern) {
+            while (pos < size && text[pos] != ch) {
+                pos++;
+            }
+            if (pos == size)
+                return -1;
+
+            res += field.starts.at(pos) ? 8 : 1;
+            if (last >= 0) {
+                res += (pos == last + 1) ? 4 : -qMin(pos - last - 1, 3);
+            } else if (pos == 0) {
+                res += 4;
+            }
+            last = pos++;
+        }
+        return qMax(res, 0);
+    }
+
+}
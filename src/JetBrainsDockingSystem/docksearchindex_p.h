@@ -0,0 +1,65 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKSEARCHINDEX_P_H
+#define DOCKSEARCHINDEX_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <QtWidgets/QAbstractButton>
+
+namespace JBDS {
+
+    // Case folded titles and ids of the tool windows, matched as subsequences of what is
+    // typed. Each entry is folded once when inserted or renamed, a pattern extending the
+    // previous one only looks at what matched before.
+    class DockSearchIndex {
+    public:
+        // Replaces the entry of a button already in the index
+        void insert(QAbstractButton *button, const QString &title, const QString &id);
+        void remove(QAbstractButton *button);
+
+        inline int size() const {
+            return m_entries.size();
+        }
+
+        // Best first, the list is reused by the next call
+        const QVector<QAbstractButton *> &match(const QString &pattern, int max);
+
+    private:
+        struct Field {
+            QString text;
+            QByteArray starts; // Non-zero where a word starts
+        };
+
+        struct Entry {
+            QAbstractButton *button;
+            Field fields[2]; // Title, id
+        };
+
+        QVector<Entry> m_entries;
+        QHash<QAbstractButton *, int> m_slots;
+
+        QString m_lastPattern;
+        QVector<int> m_lastHits;
+        bool m_lastValid = false;
+
+        QVector<QPair<int, int>> m_scored; // Score, entry
+        QVector<QAbstractButton *> m_results;
+
+        static Field field(const QString &text);
+        static int score(const Field &field, const QString &pattern);
+    };
+
+}
+
+#endif // DOCKSEARCHINDEX_P_H
@@ -3,14 +3,22 @@
 
 #include "docksidebar_p.h"
 
+#include <QtGui/QPainter>
 #include <QtWidgets/QStyle>
 
 #include "dockwidget_p.h"
 
 namespace JBDS {
 
+    // Dynamic property for style sheets, e.g. `JBDS--DockSideBar[highlight=true]`
     static const char PROPERTY_HIGHLIGHT[] = "highlight";
 
+    static QColor paletteHighlight(const QPalette &palette) {
+        auto color = palette.color(QPalette::Highlight);
+        color.setAlpha(48);
+        return color;
+    }
+
     DockSideBar::DockSideBar(JBDS::DockWidget *dock, Qt::Edge edge, QWidget *parent)
         : QFrame(parent), m_dock(dock), m_edge(edge), m_widthHint(0) {
         switch (edge) {
@@ -39,6 +47,9 @@ namespace JBDS {
         m_layout->setContentsMargins({});
         m_layout->setSpacing(0);
 
+        setProperty(PROPERTY_HIGHLIGHT, false);
+        m_paletteHighlight = paletteHighlight(palette());
+
         m_layout->addLayout(m_firstLayout);
         m_layout->addStretch();
         m_layout->addLayout(m_secondLayout);
@@ -109,6 +120,28 @@ namespace JBDS {
         dock_p->barButtonRemoved(m_edge, side, button);
     }
 
+    void DockSideBar::moveButton(Side side, int index, QAbstractButton *button) {
+        auto &cards = (side == Front) ? m_firstCards : m_secondCards;
+        auto &layout = (side == Front) ? m_firstLayout : m_secondLayout;
+
+        int cardIndex = cards.indexOf(button);
+        if (cardIndex < 0) {
+            return;
+        }
+
+        // Reorder in place, the container stays in its panel
+        cards.removeAt(cardIndex);
+        layout->removeWidget(button);
+
+        if (index >= cards.size() || index < 0) {
+            layout->addWidget(button);
+            cards.append(button);
+        } else {
+            layout->insertWidget(index, button);
+            cards.insert(index, button);
+        }
+    }
+
     void DockSideBar::buttonToggled(Side side, QAbstractButton *button) {
         auto &cards = (side == Front) ? m_firstCards : m_secondCards;
 
@@ -136,28 +169,77 @@ namespace JBDS {
     }
 
     bool DockSideBar::highlight() const {
-        return property(PROPERTY_HIGHLIGHT).toBool();
+        return m_highlight;
     }
 
     void DockSideBar::setHighlight(bool highlight, int widthHint) {
-        if (this->highlight() != highlight) {
+        if (m_highlight != highlight) {
+            m_highlight = highlight;
             setProperty(PROPERTY_HIGHLIGHT, highlight);
-            style()->polish(this);
+
+            // Selectors on the property only apply again once polished
+            if (style()->inherits("QStyleSheetStyle")) {
+                style()->unpolish(this);
+                style()->polish(this);
+            }
+            update();
         } else if (highlight) {
             return;
         }
-        if (highlight) {
+
+        // Called for every bar on each drag move, only relayout when the hint changes
+        widthHint = highlight ? widthHint : 0;
+        if (m_widthHint != widthHint) {
             m_widthHint = widthHint;
-        } else {
-            m_widthHint = 0;
+            updateGeometry();
+            DockWidgetPrivate::get(m_dock)->counters.add(DockWidget::BarHighlightRelayouts);
         }
-        updateGeometry();
     }
 
     int DockSideBar::buttonSpacing() const {
         return m_firstLayout->spacing();
     }
 
+    QColor DockSideBar::highlightColor() const {
+        return m_highlightColor.isValid() ? m_highlightColor : m_paletteHighlight;
+    }
+
+    void DockSideBar::setHighlightColor(const QColor &color) {
+        m_highlightColor = color;
+        if (m_highlight) {
+            update();
+        }
+    }
+
+    int DockSideBar::padding() const {
+        return contentsMargins().left();
+    }
+
+    void DockSideBar::setPadding(int padding) {
+        setContentsMargins(padding, padding, padding, padding);
+    }
+
+    void DockSideBar::changeEvent(QEvent *event) {
+        switch (event->type()) {
+            case QEvent::PaletteChange:
+            case QEvent::StyleChange:
+                m_paletteHighlight = paletteHighlight(palette());
+                break;
+            default:
+                break;
+        }
+        QFrame::changeEvent(event);
+    }
+
+    // A style sheet styling the bar paints the highlight through the property
+    void DockSideBar::paintEvent(QPaintEvent *event) {
+        if (m_highlight && !testAttribute(Qt::WA_StyleSheetTarget)) {
+            QPainter painter(this);
+            painter.fillRect(rect(), highlightColor());
+        }
+        QFrame::paintEvent(event);
+    }
+
     void DockSideBar::setButtonSpacing(int spacing) {
         m_firstLayout->setSpacing(spacing);
         m_secondLayout->setSpacing(spacing);
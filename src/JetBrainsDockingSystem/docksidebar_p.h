@@ -22,6 +22,8 @@ namespace JBDS {
     class DockSideBar : public QFrame {
         Q_OBJECT
         Q_PROPERTY(int buttonSpacing READ buttonSpacing WRITE setButtonSpacing)
+        Q_PROPERTY(QColor highlightColor READ highlightColor WRITE setHighlightColor)
+        Q_PROPERTY(int padding READ padding WRITE setPadding)
     public:
         explicit DockSideBar(DockWidget *dock, Qt::Edge edge, QWidget *parent = nullptr);
         ~DockSideBar();
@@ -46,11 +48,16 @@ namespace JBDS {
 
         void insertButton(Side side, int index, QAbstractButton *button);
         void removeButton(Side side, QAbstractButton *button);
+        void moveButton(Side side, int index, QAbstractButton *button);
 
-        inline QList<QAbstractButton *> buttons(Side side) const {
+        inline const QList<QAbstractButton *> &buttons(Side side) const {
             return (side == Front) ? m_firstCards : m_secondCards;
         }
 
+        inline int indexOf(Side side, QAbstractButton *button) const {
+            return ((side == Front) ? m_firstCards : m_secondCards).indexOf(button);
+        }
+
         inline int count(Side side) const {
             return ((side == Front) ? m_firstCards : m_secondCards).size();
         }
@@ -64,6 +71,17 @@ namespace JBDS {
         int buttonSpacing() const;
         void setButtonSpacing(int spacing);
 
+        // Derived from the palette unless set, e.g. by `qproperty-highlightColor`
+        QColor highlightColor() const;
+        void setHighlightColor(const QColor &color);
+
+        int padding() const;
+        void setPadding(int padding);
+
+    protected:
+        void changeEvent(QEvent *event) override;
+        void paintEvent(QPaintEvent *event) override;
+
     protected:
         DockWidget *m_dock;
 
@@ -78,6 +96,10 @@ namespace JBDS {
         QList<QAbstractButton *> m_secondCards;
 
         int m_widthHint;
+
+        bool m_highlight = false;
+        QColor m_highlightColor;
+        QColor m_paletteHighlight; // Cached, paints happen on every drag move
     };
 
 }
@@ -0,0 +1,252 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "docksplitter_p.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QPainter>
+#include <QtGui/QtEvents>
+#include <QtWidgets/QLayout>
+
+namespace JBDS {
+
+    static const int frameTimeout = 250; // Milliseconds
+
+    DockSplitterHandle::DockSplitterHandle(Qt::Orientation orientation, QSplitter *parent)
+        : QSplitterHandle(orientation, parent) {
+    }
+
+    DockSplitterHandle::~DockSplitterHandle() {
+    }
+
+    void DockSplitterHandle::mousePressEvent(QMouseEvent *event) {
+        if (event->button() == Qt::LeftButton && !m_dragging) {
+            auto s = static_cast<DockSplitter *>(splitter());
+            m_dragging = true;
+            m_slowFrames = 0;
+
+            // The user may have turned the tuning off since the last drag
+            if (s->m_degraded && (!s->m_tuning || !s->m_tuning->adaptive)) {
+                s->m_degraded = false;
+                s->setOpaqueResize(true);
+            }
+            emit s->handlePressed();
+        }
+        QSplitterHandle::mousePressEvent(event);
+    }
+
+    // A frame is the relayout caused by a handle move plus the paint Qt schedules for it,
+    // the relayout is timed here and the paint when the window processes its update request
+    void DockSplitterHandle::mouseMoveEvent(QMouseEvent *event) {
+        auto s = static_cast<DockSplitter *>(splitter());
+        auto tuning = s->m_tuning;
+        if (!m_dragging || !tuning || !tuning->adaptive || !s->opaqueResize()) {
+            QSplitterHandle::mouseMoveEvent(event);
+            return;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QSplitterHandle::mouseMoveEvent(event);
+        startFrame(timer.nsecsElapsed() / 1000, false);
+    }
+
+    void DockSplitterHandle::mouseReleaseEvent(QMouseEvent *event) {
+        auto s = static_cast<DockSplitter *>(splitter());
+        auto tuning = s->m_tuning;
+
+        // A non-opaque splitter moves on release, let it finish before thawing the content
+        auto release = [&]() {
+            QSplitterHandle::mouseReleaseEvent(event);
+            if (event->button() == Qt::LeftButton && m_dragging) {
+                m_dragging = false;
+                emit s->handleReleased();
+            }
+        };
+
+        if (event->button() != Qt::LeftButton || !m_dragging || !s->m_degraded || !tuning ||
+            !tuning->adaptive) {
+            release();
+            return;
+        }
+
+        // The final frame tells whether the content became cheap again
+        QElapsedTimer timer;
+        timer.start();
+        release();
+        startFrame(timer.nsecsElapsed() / 1000, true);
+    }
+
+    bool DockSplitterHandle::eventFilter(QObject *obj, QEvent *event) {
+        if (event->type() == QEvent::UpdateRequest && obj == m_filtered && m_framePending &&
+            !m_paintTimer.isValid()) {
+            // Runs once the update request, which paints the window, has been delivered
+            m_frameTimeout.stop();
+            m_paintTimer.start();
+            QMetaObject::invokeMethod(this, &DockSplitterHandle::finishFrame,
+                                      Qt::QueuedConnection);
+        }
+        return QSplitterHandle::eventFilter(obj, event);
+    }
+
+    // A hidden or minimized window may never paint again
+    void DockSplitterHandle::timerEvent(QTimerEvent *event) {
+        if (event->timerId() != m_frameTimeout.timerId()) {
+            QSplitterHandle::timerEvent(event);
+            return;
+        }
+        m_frameTimeout.stop();
+        if (!m_paintTimer.isValid()) {
+            endFrame();
+        }
+    }
+
+    // Moves coalesced into one paint count the relayout of the last one. The window is
+    // filtered only while a frame waits for its paint.
+    void DockSplitterHandle::startFrame(qint64 layoutCost, bool recovery) {
+        m_layoutCost = layoutCost;
+        m_frameRecovery = recovery;
+        if (!m_framePending) {
+            m_framePending = true;
+            m_filtered = window();
+            m_filtered->installEventFilter(this);
+        }
+        m_frameTimeout.start(frameTimeout, this);
+    }
+
+    void DockSplitterHandle::endFrame() {
+        m_framePending = false;
+        if (m_filtered) {
+            m_filtered->removeEventFilter(this);
+            m_filtered = nullptr;
+        }
+    }
+
+    void DockSplitterHandle::finishFrame() {
+        auto s = static_cast<DockSplitter *>(splitter());
+        auto tuning = s->m_tuning;
+        auto elapsed = m_layoutCost + m_paintTimer.nsecsElapsed() / 1000;
+        m_paintTimer.invalidate();
+        endFrame();
+        if (!tuning || !tuning->adaptive)
+            return;
+
+        if (m_frameRecovery) {
+            if (s->m_degraded && elapsed <= tuning->recoveryBudget) {
+                s->m_degraded = false;
+                s->setOpaqueResize(true);
+                tuning->recoveries++;
+            }
+            return;
+        }
+
+        if (!m_dragging || !s->opaqueResize())
+            return;
+        if (elapsed <= tuning->budget) {
+            m_slowFrames = 0;
+            return;
+        }
+
+        // A single slow frame may just be a cold cache
+        if (++m_slowFrames < 2)
+            return;
+        s->m_degraded = true;
+        s->setOpaqueResize(false);
+        tuning->fallbacks++;
+    }
+
+    void DockSplitterHandle::paintEvent(QPaintEvent *event) {
+        // A rule may target the handle without the splitter, or the other way round
+        auto s = static_cast<DockSplitter *>(splitter());
+        if (testAttribute(Qt::WA_StyleSheetTarget)) {
+            QSplitterHandle::paintEvent(event);
+            return;
+        }
+
+        QPainter painter(this);
+        painter.fillRect(rect(), s->handleColor());
+    }
+
+    DockSplitter::DockSplitter(Qt::Orientation orientation, QWidget *parent)
+        : QSplitter(orientation, parent) {
+    }
+
+    DockSplitter::~DockSplitter() {
+    }
+
+    QColor DockSplitter::handleColor() const {
+        if (m_handleColor.isValid())
+            return m_handleColor;
+        return palette().color(QPalette::Midlight);
+    }
+
+    void DockSplitter::setHandleColor(const QColor &color) {
+        m_handleColor = color;
+        for (int i = 0; i < count(); ++i) {
+            handle(i)->update();
+        }
+    }
+
+    QSplitterHandle *DockSplitter::createHandle() {
+        return new DockSplitterHandle(orientation(), this);
+    }
+
+    DockContentSnapshot::DockContentSnapshot(QWidget *parent) : QWidget(parent) {
+        setAttribute(Qt::WA_OpaquePaintEvent);
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+    }
+
+    DockContentSnapshot::~DockContentSnapshot() {
+    }
+
+    DockContentSnapshot *DockContentSnapshot::freeze(QWidget *w,
+                                                     std::atomic<quint64> *eventCounter) {
+        if (auto layout = w->layout()) {
+            layout->activate();
+        }
+        auto pixmap = w->grab();
+
+        auto snapshot = new DockContentSnapshot(w);
+        snapshot->m_pixmap = pixmap;
+        snapshot->m_eventCounter = eventCounter;
+        snapshot->setGeometry(w->rect());
+        w->installEventFilter(snapshot);
+        if (auto layout = w->layout()) {
+            layout->setEnabled(false);
+        }
+        snapshot->show();
+        snapshot->raise();
+        return snapshot;
+    }
+
+    void DockContentSnapshot::thaw() {
+        auto w = parentWidget();
+        w->removeEventFilter(this);
+        hide();
+
+        // The content is laid out once, with the final size
+        if (auto layout = w->layout()) {
+            layout->setEnabled(true);
+            layout->setGeometry(w->contentsRect());
+        }
+        deleteLater();
+    }
+
+    bool DockContentSnapshot::eventFilter(QObject *obj, QEvent *event) {
+        if (m_eventCounter) {
+            m_eventCounter->fetch_add(1, std::memory_order_relaxed);
+        }
+        if (obj == parentWidget() && event->type() == QEvent::Resize) {
+            setGeometry(parentWidget()->rect());
+        }
+        return QWidget::eventFilter(obj, event);
+    }
+
+    void DockContentSnapshot::paintEvent(QPaintEvent *event) {
+        Q_UNUSED(event)
+
+        QPainter painter(this);
+        painter.drawPixmap(rect(), m_pixmap);
+    }
+
+}
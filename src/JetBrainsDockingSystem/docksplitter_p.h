@@ -0,0 +1,129 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKSPLITTER_P_H
+#define DOCKSPLITTER_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <atomic>
+
+#include <QtCore/QBasicTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
+#include <QtGui/QPixmap>
+#include <QtWidgets/QSplitter>
+
+namespace JBDS {
+
+    // Shared by all splitters of a dock, times are in microseconds
+    struct DockResizeTuning {
+        bool adaptive = false;
+        int budget = 16000;         // A drag falls back to rubber band above this
+        int recoveryBudget = 8000;  // The splitter is opaque again below this
+
+        int fallbacks = 0;
+        int recoveries = 0;
+    };
+
+    class DockSplitterHandle : public QSplitterHandle {
+        Q_OBJECT
+    public:
+        DockSplitterHandle(Qt::Orientation orientation, QSplitter *parent);
+        ~DockSplitterHandle();
+
+    protected:
+        void mousePressEvent(QMouseEvent *event) override;
+        void mouseMoveEvent(QMouseEvent *event) override;
+        void mouseReleaseEvent(QMouseEvent *event) override;
+        void paintEvent(QPaintEvent *event) override;
+        bool eventFilter(QObject *obj, QEvent *event) override;
+        void timerEvent(QTimerEvent *event) override;
+
+        void startFrame(qint64 layoutCost, bool recovery);
+        void endFrame();
+        void finishFrame();
+
+        bool m_dragging = false;
+        int m_slowFrames = 0;
+
+        // Frame waiting for its paint, the window is filtered meanwhile
+        bool m_framePending = false;
+        bool m_frameRecovery = false;
+        qint64 m_layoutCost = 0;
+        QElapsedTimer m_paintTimer;
+        QBasicTimer m_frameTimeout;
+        QPointer<QWidget> m_filtered;
+    };
+
+    class DockSplitter : public QSplitter {
+        Q_OBJECT
+        Q_PROPERTY(QColor handleColor READ handleColor WRITE setHandleColor)
+    public:
+        explicit DockSplitter(Qt::Orientation orientation, QWidget *parent = nullptr);
+        ~DockSplitter();
+
+        inline DockResizeTuning *tuning() const {
+            return m_tuning;
+        }
+
+        inline void setTuning(DockResizeTuning *tuning) {
+            m_tuning = tuning;
+        }
+
+        // Used when no style sheet targets the splitter, derived from the palette unless set
+        QColor handleColor() const;
+        void setHandleColor(const QColor &color);
+
+    Q_SIGNALS:
+        void handlePressed();
+        void handleReleased();
+
+    protected:
+        QSplitterHandle *createHandle() override;
+
+        DockResizeTuning *m_tuning = nullptr;
+        QColor m_handleColor;
+
+        // Opaque resize was turned off by the tuning, not by the user
+        bool m_degraded = false;
+
+        friend class DockSplitterHandle;
+    };
+
+    // Covers a widget with a picture of itself and stops its layout until thawed, the
+    // picture is stretched to follow the widget size in the meantime.
+    class DockContentSnapshot : public QWidget {
+        Q_OBJECT
+    public:
+        ~DockContentSnapshot();
+
+        // Events filtered from the widget are counted when a counter is given
+        static DockContentSnapshot *freeze(QWidget *w,
+                                           std::atomic<quint64> *eventCounter = nullptr);
+        void thaw();
+
+        inline const QPixmap &pixmap() const {
+            return m_pixmap;
+        }
+
+    protected:
+        explicit DockContentSnapshot(QWidget *parent);
+
+        bool eventFilter(QObject *obj, QEvent *event) override;
+        void paintEvent(QPaintEvent *event) override;
+
+        QPixmap m_pixmap;
+        std::atomic<quint64> *m_eventCounter = nullptr;
+    };
+
+}
+
+#endif // DOCKSPLITTER_P_H
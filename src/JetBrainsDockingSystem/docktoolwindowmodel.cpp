@@ -0,0 +1,291 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "docktoolwindowmodel.h"
+#include "docktoolwindowmodel_p.h"
+
+#include <algorithm>
+
+#include "dockwidget_p.h"
+#include "docksidebar_p.h"
+
+namespace JBDS {
+
+    DockToolWindowModelPrivate::DockToolWindowModelPrivate() {
+    }
+
+    DockToolWindowModelPrivate::~DockToolWindowModelPrivate() {
+    }
+
+    void DockToolWindowModelPrivate::init() {
+        Q_Q(DockToolWindowModel);
+        if (!dock)
+            return;
+
+        for (int stripe = 0; stripe < 8; ++stripe) {
+            dock->forEachToolWindow(index2edge(stripe / 2), Side(stripe % 2),
+                                    [this, stripe](QAbstractButton *button, QWidget *) {
+                                        rows.append(button);
+                                        stripes.insert(button, stripe);
+                                        counts[stripe]++;
+                                    });
+        }
+
+        QObject::connect(dock, &DockWidget::toolWindowAdded, q, [this](QAbstractButton *button) {
+            toolWindowAdded(button); //
+        });
+        QObject::connect(dock, &DockWidget::toolWindowRemoved, q,
+                         [this](QAbstractButton *button) {
+                             toolWindowRemoved(button); //
+                         });
+        QObject::connect(dock, &DockWidget::toolWindowMoved, q, [this](QAbstractButton *button) {
+            toolWindowMoved(button); //
+        });
+        QObject::connect(dock, &DockWidget::viewModeChanged, q, [this](QAbstractButton *button) {
+            toolWindowChanged(button, {DockToolWindowModel::ViewModeRole});
+        });
+
+        // Tool windows created on demand get their content when shown the first time
+        QObject::connect(dock, &DockWidget::visibilityChanged, q,
+                         [this](QAbstractButton *button) {
+                             toolWindowChanged(button, {DockToolWindowModel::VisibleRole,
+                                                        DockToolWindowModel::MaterializedRole});
+                         });
+        QObject::connect(dock, &DockWidget::appearanceChanged, q,
+                         [this](QAbstractButton *button) {
+                             toolWindowChanged(button, {Qt::DisplayRole, Qt::DecorationRole});
+                         });
+        QObject::connect(dock, &QObject::destroyed, q, [this]() {
+            dockDestroyed(); //
+        });
+    }
+
+    // Edge index times two plus the side
+    int DockToolWindowModelPrivate::stripeOf(const QAbstractButton *button) const {
+        const auto &data = DockWidgetPrivate::get(dock.data())->buttonData(button);
+        return edge2index(data.edge) * 2 + data.side;
+    }
+
+    int DockToolWindowModelPrivate::offset(int stripe) const {
+        int res = 0;
+        for (int i = 0; i < stripe; ++i) {
+            res += counts[i];
+        }
+        return res;
+    }
+
+    int DockToolWindowModelPrivate::rowOf(const QAbstractButton *button) const {
+        auto it = stripes.constFind(button);
+        if (it == stripes.constEnd())
+            return -1;
+
+        int begin = offset(it.value());
+        int end = begin + counts[it.value()];
+        for (int row = begin; row < end; ++row) {
+            if (rows.at(row) == button)
+                return row;
+        }
+        return -1;
+    }
+
+    // Where the dock has put it, counted among the rows without it
+    int DockToolWindowModelPrivate::insertionRow(QAbstractButton *button, int stripe) const {
+        auto bar = DockWidgetPrivate::get(dock.data())->bars[stripe / 2];
+        int index = bar ? bar->indexOf(Side(stripe % 2), button) : -1;
+        if (index < 0 || index > counts[stripe]) {
+            index = counts[stripe];
+        }
+        return offset(stripe) + index;
+    }
+
+    void DockToolWindowModelPrivate::toolWindowAdded(QAbstractButton *button) {
+        Q_Q(DockToolWindowModel);
+        if (!dock || stripes.contains(button))
+            return;
+
+        int stripe = stripeOf(button);
+        int row = insertionRow(button, stripe);
+        q->beginInsertRows(QModelIndex(), row, row);
+        rows.insert(row, button);
+        stripes.insert(button, stripe);
+        counts[stripe]++;
+        q->endInsertRows();
+
+        ordersChanged(stripe, row + 1);
+    }
+
+    void DockToolWindowModelPrivate::toolWindowRemoved(QAbstractButton *button) {
+        Q_Q(DockToolWindowModel);
+        int row = rowOf(button);
+        if (row < 0)
+            return;
+
+        int stripe = stripes.value(button);
+        q->beginRemoveRows(QModelIndex(), row, row);
+        rows.remove(row);
+        stripes.remove(button);
+        counts[stripe]--;
+        q->endRemoveRows();
+
+        ordersChanged(stripe, row);
+    }
+
+    void DockToolWindowModelPrivate::toolWindowMoved(QAbstractButton *button) {
+        Q_Q(DockToolWindowModel);
+        int from = rowOf(button);
+        if (!dock || from < 0)
+            return;
+
+        int oldStripe = stripes.value(button);
+        int oldIndex = from - offset(oldStripe);
+        int newStripe = stripeOf(button);
+
+        // Rows of the later stripes move up by one once it's taken out
+        int to = insertionRow(button, newStripe);
+        if (newStripe > oldStripe) {
+            to--;
+        }
+
+        // The destination of a move is counted among the rows before it
+        bool moving = to != from;
+        if (moving) {
+            q->beginMoveRows(QModelIndex(), from, from, QModelIndex(), (to > from) ? to + 1 : to);
+        }
+        rows.remove(from);
+        rows.insert(to, button);
+        stripes[button] = newStripe;
+        counts[oldStripe]--;
+        counts[newStripe]++;
+        if (moving) {
+            q->endMoveRows();
+        }
+
+        if (newStripe == oldStripe) {
+            ordersChanged(newStripe, qMin(from, to));
+            return;
+        }
+        auto index = q->index(to);
+        emit q->dataChanged(index, index,
+                            {DockToolWindowModel::EdgeRole, DockToolWindowModel::SideRole});
+        ordersChanged(oldStripe, offset(oldStripe) + oldIndex);
+        ordersChanged(newStripe, to);
+    }
+
+    void DockToolWindowModelPrivate::toolWindowChanged(QAbstractButton *button,
+                                                       const QVector<int> &roles) {
+        Q_Q(DockToolWindowModel);
+        int row = rowOf(button);
+        if (row < 0)
+            return;
+        auto index = q->index(row);
+        emit q->dataChanged(index, index, roles);
+    }
+
+    // The rows of a stripe from the given one on have a new order
+    void DockToolWindowModelPrivate::ordersChanged(int stripe, int from) {
+        Q_Q(DockToolWindowModel);
+        int last = offset(stripe) + counts[stripe] - 1;
+        if (from > last)
+            return;
+        emit q->dataChanged(q->index(from), q->index(last), {DockToolWindowModel::OrderRole});
+    }
+
+    // Its tool windows went with it
+    void DockToolWindowModelPrivate::dockDestroyed() {
+        Q_Q(DockToolWindowModel);
+        if (rows.isEmpty())
+            return;
+        q->beginRemoveRows(QModelIndex(), 0, rows.size() - 1);
+        rows.clear();
+        stripes.clear();
+        std::fill(std::begin(counts), std::end(counts), 0);
+        q->endRemoveRows();
+    }
+
+    DockToolWindowModel::DockToolWindowModel(DockWidget *dock, QObject *parent)
+        : QAbstractListModel(parent), d_ptr(new DockToolWindowModelPrivate()) {
+        Q_D(DockToolWindowModel);
+        d->q_ptr = this;
+        d->dock = dock;
+        d->init();
+    }
+
+    DockToolWindowModel::~DockToolWindowModel() {
+    }
+
+    DockWidget *DockToolWindowModel::dock() const {
+        Q_D(const DockToolWindowModel);
+        return d->dock;
+    }
+
+    QAbstractButton *DockToolWindowModel::button(const QModelIndex &index) const {
+        Q_D(const DockToolWindowModel);
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid))
+            return nullptr;
+        return d->rows.at(index.row());
+    }
+
+    QModelIndex DockToolWindowModel::indexOf(const QAbstractButton *button) const {
+        Q_D(const DockToolWindowModel);
+        int row = d->rowOf(button);
+        return (row < 0) ? QModelIndex() : index(row);
+    }
+
+    int DockToolWindowModel::rowCount(const QModelIndex &parent) const {
+        Q_D(const DockToolWindowModel);
+        return parent.isValid() ? 0 : d->rows.size();
+    }
+
+    // Enums are held as their int value
+    QVariant DockToolWindowModel::data(const QModelIndex &index, int role) const {
+        Q_D(const DockToolWindowModel);
+        if (!d->dock || !checkIndex(index, CheckIndexOption::IndexIsValid))
+            return {};
+
+        auto button = d->rows.at(index.row());
+        const auto &data = DockWidgetPrivate::get(d->dock.data())->buttonData(button);
+        switch (role) {
+            case Qt::DisplayRole: {
+                auto text = button->text();
+                return text.isEmpty() ? data.id : text;
+            }
+            case Qt::DecorationRole:
+                return button->icon();
+            case IdRole:
+                return data.id;
+            case EdgeRole:
+                return int(data.edge);
+            case SideRole:
+                return int(data.side);
+            case OrderRole:
+                return index.row() - d->offset(d->stripes.value(button));
+            case ViewModeRole:
+                return int(data.viewMode);
+            case VisibleRole:
+                return button->isChecked();
+            case MaterializedRole:
+                return data.widget != nullptr;
+            case ButtonRole:
+                return QVariant::fromValue(button);
+            default:
+                break;
+        }
+        return {};
+    }
+
+    QHash<int, QByteArray> DockToolWindowModel::roleNames() const {
+        auto res = QAbstractListModel::roleNames();
+        res.insert(Qt::DisplayRole, "title");
+        res.insert(Qt::DecorationRole, "icon");
+        res.insert(IdRole, "id");
+        res.insert(EdgeRole, "edge");
+        res.insert(SideRole, "side");
+        res.insert(OrderRole, "order");
+        res.insert(ViewModeRole, "viewMode");
+        res.insert(VisibleRole, "visible");
+        res.insert(MaterializedRole, "materialized");
+        res.insert(ButtonRole, "button");
+        return res;
+    }
+
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKTOOLWINDOWMODEL_H
+#define DOCKTOOLWINDOWMODEL_H
+
+#include <QtCore/QAbstractListModel>
+#include <QtWidgets/QAbstractButton>
+
+#include <JetBrainsDockingSystem/jbdsglobal.h>
+
+namespace JBDS {
+
+    class DockWidget;
+
+    class DockToolWindowModelPrivate;
+
+    // Every tool window of a dock, one row each, in the order of the bars: left, top, right,
+    // bottom, the front side before the back side. Rows are inserted, removed, moved and
+    // updated as the dock changes, the model is never reset.
+    class JBDS_EXPORT DockToolWindowModel : public QAbstractListModel {
+        Q_OBJECT
+        Q_DECLARE_PRIVATE(DockToolWindowModel)
+    public:
+        explicit DockToolWindowModel(DockWidget *dock, QObject *parent = nullptr);
+        ~DockToolWindowModel();
+
+        // The display role is the text of the button, or the id if it has none, the
+        // decoration role its icon
+        enum Role {
+            IdRole = Qt::UserRole + 1,
+            EdgeRole,
+            SideRole,
+            OrderRole, // Position on its side of the bar
+            ViewModeRole,
+            VisibleRole,
+            MaterializedRole,
+            ButtonRole,
+        };
+
+        DockWidget *dock() const;
+
+        QAbstractButton *button(const QModelIndex &index) const;
+        QModelIndex indexOf(const QAbstractButton *button) const;
+
+        int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+        QHash<int, QByteArray> roleNames() const override;
+
+    protected:
+        QScopedPointer<DockToolWindowModelPrivate> d_ptr;
+    };
+
+}
+
+#endif // DOCKTOOLWINDOWMODEL_H
@@ -0,0 +1,57 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef DOCKTOOLWINDOWMODEL_P_H
+#define DOCKTOOLWINDOWMODEL_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+
+#include <JetBrainsDockingSystem/docktoolwindowmodel.h>
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+namespace JBDS {
+
+    class DockToolWindowModelPrivate {
+        Q_DECLARE_PUBLIC(DockToolWindowModel)
+    public:
+        DockToolWindowModelPrivate();
+        ~DockToolWindowModelPrivate();
+
+        void init();
+
+        DockToolWindowModel *q_ptr;
+
+        QPointer<DockWidget> dock;
+
+        // The rows as the views know them, grouped by stripe, see `stripeOf`
+        QVector<QAbstractButton *> rows;
+        QHash<const QAbstractButton *, int> stripes;
+        int counts[8] = {};
+
+        int stripeOf(const QAbstractButton *button) const;
+        int offset(int stripe) const;
+        int rowOf(const QAbstractButton *button) const;
+        int insertionRow(QAbstractButton *button, int stripe) const;
+
+        void toolWindowAdded(QAbstractButton *button);
+        void toolWindowRemoved(QAbstractButton *button);
+        void toolWindowMoved(QAbstractButton *button);
+        void toolWindowChanged(QAbstractButton *button, const QVector<int> &roles);
+        void ordersChanged(int stripe, int from);
+        void dockDestroyed();
+    };
+
+}
+
+#endif // DOCKTOOLWINDOWMODEL_P_H
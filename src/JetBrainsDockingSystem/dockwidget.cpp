@@ -4,11 +4,15 @@
 #include "dockwidget.h"
 #include "dockwidget_p.h"
 
+#include <QtCore/QMetaEnum>
+#include <QtCore/QPointer>
+#include <QtCore/QSignalBlocker>
 #include <QtCore/QTimer>
 #include <QtGui/QtEvents>
 #include <QtGui/QWindow>
 #include <QtGui/QPixmap>
 #include <QtGui/QGuiApplication>
+#include <QtWidgets/QApplication>
 
 #if QT_VERSION < QT_VERSION_CHECK(6, 7, 0)
 
@@ -54,6 +58,8 @@ static inline void setAppActiveWindow(QWidget *w) {
 #include "dockbutton.h"
 
 #include "qmfloatingwindowhelper_p.h"
+#include "jbdsperf_p.h"
+#include "dockprofiler_p.h"
 
 namespace JBDS {
 
@@ -78,16 +84,23 @@ namespace JBDS {
         return pixmap;
     }
 
-    static void adjustWindowGeometry(QWidget *w) {
-        auto screen = w->screen();
-        auto screenGeometry = screen->geometry();
-        if (w->x() < screenGeometry.left() || w->y() < screenGeometry.top()) {
-            w->move(qMax(w->x(), screenGeometry.left()), qMax(w->y(), screenGeometry.top()));
+    static QRect fitToScreen(QRect rect, const QRect &screenGeometry) {
+        if (rect.x() < screenGeometry.left() || rect.y() < screenGeometry.top()) {
+            rect.moveTo(qMax(rect.x(), screenGeometry.left()),
+                        qMax(rect.y(), screenGeometry.top()));
+        }
+        if (rect.x() + rect.width() > screenGeometry.right() ||
+            rect.y() + rect.height() > screenGeometry.bottom()) {
+            rect.moveTo(qMin(rect.x(), screenGeometry.right() - rect.width()),
+                        qMin(rect.y(), screenGeometry.bottom() - rect.height()));
         }
-        if (w->x() + w->width() > screenGeometry.right() ||
-            w->y() + w->height() > screenGeometry.bottom()) {
-            w->move(qMin(w->x(), screenGeometry.right() - w->width()),
-                    qMin(w->y(), screenGeometry.bottom() - w->height()));
+        return rect;
+    }
+
+    static void adjustWindowGeometry(QWidget *w) {
+        auto rect = fitToScreen(QRect(w->pos(), w->size()), w->screen()->geometry());
+        if (rect.topLeft() != w->pos()) {
+            w->move(rect.topLeft());
         }
     }
 
@@ -130,6 +143,10 @@ namespace JBDS {
 
     protected:
         bool eventFilter(QObject *obj, QEvent *event) override {
+            d->counters.add(DockWidget::WidgetFilterEvents);
+            if (d->profiler) {
+                d->profiler->toolWindowEvent(button, event);
+            }
             switch (event->type()) {
                 case QEvent::Close: {
                     closing = true;
@@ -142,7 +159,7 @@ namespace JBDS {
                     if (closing) {
                         // Close accepted
                         button->setChecked(false);
-                        if (d->buttonDataHash.value(button).viewMode == DockPinned) {
+                        if (d->buttonData(button).viewMode == DockPinned) {
                             QTimer::singleShot(0, this, [this]() {
                                 widget->show(); //
                             });
@@ -153,13 +170,15 @@ namespace JBDS {
                 case QEvent::Show:
                 case QEvent::Move:
                 case QEvent::Resize: {
-                    if (d->buttonDataHash.value(button).viewMode != DockPinned) {
-                        oldGeometry = widget->geometry();
+                    // Also installed on the pooled hosts
+                    auto target = static_cast<QWidget *>(obj);
+                    if (target->isWindow()) {
+                        oldGeometry = target->geometry();
                     }
                     break;
                 }
                 case QEvent::KeyPress: {
-                    if (!widget->isWindow()) {
+                    if (!static_cast<QWidget *>(obj)->isWindow()) {
                         break;
                     }
 
@@ -265,7 +284,12 @@ namespace JBDS {
             window.setCheckable(true);
             window.setChecked(data.viewMode == Window);
 
+            QAction undocked(QCoreApplication::translate("JetBrainsDockingSystem", "Undocked"));
+            undocked.setCheckable(true);
+            undocked.setChecked(data.viewMode == Undocked);
+
             menu->addAction(&dockPinned);
+            menu->addAction(&undocked);
             menu->addAction(&floating);
             menu->addAction(&window);
 
@@ -279,6 +303,8 @@ namespace JBDS {
                 mode = Floating;
             } else if (action == &window) {
                 mode = Window;
+            } else if (action == &undocked) {
+                mode = Undocked;
             } else {
                 return;
             }
@@ -286,6 +312,7 @@ namespace JBDS {
         }
 
         bool eventFilter(QObject *obj, QEvent *event) override {
+            d->counters.add(DockWidget::ButtonFilterEvents);
             switch (event->type()) {
                 case QEvent::MouseButtonPress:
                     mousePressEvent(static_cast<QMouseEvent *>(event));
@@ -307,6 +334,16 @@ namespace JBDS {
                     contextMenuEvent(static_cast<QContextMenuEvent *>(event));
                     return true;
 
+                // Buttons tell nobody about a new text or icon, they repaint. Reported
+                // afterwards, the receivers are free to change widgets.
+                case QEvent::Paint:
+                    if (d->appearanceOutdated(button)) {
+                        QTimer::singleShot(0, this, [this]() {
+                            d->updateAppearance(button); //
+                        });
+                    }
+                    break;
+
                 default:
                     break;
             }
@@ -318,12 +355,27 @@ namespace JBDS {
     }
 
     DockWidgetPrivate::~DockWidgetPrivate() {
-        for (auto it = widgetIndexes.begin(); it != widgetIndexes.end(); ++it) {
-            const auto &w = it.key();
-            const auto &button = it.value();
-            disconnect(w, &QObject::destroyed, this, &DockWidgetPrivate::_q_widgetDestroyed);
+        for (auto it = buttonDataHash.begin(); it != buttonDataHash.end(); ++it) {
+            const auto &button = it.key();
+            const auto &w = it->widget;
+            if (w) {
+                disconnect(w, &QObject::destroyed, this, &DockWidgetPrivate::_q_widgetDestroyed);
+            }
             disconnect(button, &QObject::destroyed, this, &DockWidgetPrivate::_q_buttonDestroyed);
         }
+        // The content leaves a pooled host like it leaves its own window: back to its
+        // container, which the dock deletes, or out of the dock as a top level widget
+        for (const auto &data : std::as_const(buttonDataHash)) {
+            auto w = data.widget;
+            if (w && data.hosts[0] && w->parentWidget() == data.hosts[0]) {
+                w->setParent(data.container);
+            } else if (w && data.hosts[1] && w->parentWidget() == data.hosts[1]) {
+                w->setParent(nullptr);
+            }
+            for (auto host : data.hosts) {
+                delete host;
+            }
+        }
     }
 
     void DockWidgetPrivate::init() {
@@ -335,20 +387,6 @@ namespace JBDS {
         mainLayout->setContentsMargins({});
         mainLayout->setSpacing(0);
 
-        bars[0] = new DockSideBar(q, Qt::LeftEdge);
-        bars[0]->setObjectName("left-bar");
-        bars[1] = new DockSideBar(q, Qt::TopEdge);
-        bars[1]->setObjectName("top-bar");
-        bars[2] = new DockSideBar(q, Qt::RightEdge);
-        bars[2]->setObjectName("right-bar");
-        bars[3] = new DockSideBar(q, Qt::BottomEdge);
-        bars[3]->setObjectName("bottom-bar");
-
-        panels[0] = new DockPanel(Qt::Vertical);
-        panels[1] = new DockPanel(Qt::Horizontal);
-        panels[2] = new DockPanel(Qt::Vertical);
-        panels[3] = new DockPanel(Qt::Horizontal);
-
         centralContainer = new QStackedWidget();
 
         /*
@@ -363,32 +401,30 @@ namespace JBDS {
          *
          */
 
-        horizontalSplitter = new QSplitter(Qt::Horizontal);
+        // Panels and bars are created when an edge is used for the first time
+        horizontalSplitter = new DockSplitter(Qt::Horizontal);
         horizontalSplitter->setObjectName("dock-splitter");
         horizontalSplitter->setChildrenCollapsible(false);
-        horizontalSplitter->addWidget(panels[0]);
         horizontalSplitter->addWidget(centralContainer);
-        horizontalSplitter->addWidget(panels[2]);
+        horizontalSplitter->setStretchFactor(0, 1);
 
-        horizontalSplitter->setStretchFactor(0, 0);
-        horizontalSplitter->setStretchFactor(1, 1);
-        horizontalSplitter->setStretchFactor(2, 0);
-
-        verticalSplitter = new QSplitter(Qt::Vertical);
+        verticalSplitter = new DockSplitter(Qt::Vertical);
         verticalSplitter->setObjectName("dock-splitter");
         verticalSplitter->setChildrenCollapsible(false);
-        verticalSplitter->addWidget(panels[1]);
         verticalSplitter->addWidget(horizontalSplitter);
-        verticalSplitter->addWidget(panels[3]);
+        verticalSplitter->setStretchFactor(0, 1);
+
+        connectSplitter(horizontalSplitter);
+        connectSplitter(verticalSplitter);
 
-        verticalSplitter->setStretchFactor(0, 0);
-        verticalSplitter->setStretchFactor(1, 1);
-        verticalSplitter->setStretchFactor(2, 0);
+        // Undocked tool windows follow the area between the bars
+        verticalSplitter->installEventFilter(this);
+        connect(qApp, &QApplication::focusChanged, this, &DockWidgetPrivate::_q_focusChanged);
 
-        mainLayout->addWidget(bars[0], 1, 0);
-        mainLayout->addWidget(bars[1], 0, 1);
-        mainLayout->addWidget(bars[2], 1, 2);
-        mainLayout->addWidget(bars[3], 2, 1);
+        for (int i = 0; i < 4; ++i) {
+            barPlaceholders[i] = new QSpacerItem(0, 0, QSizePolicy::Fixed, QSizePolicy::Fixed);
+            mainLayout->addItem(barPlaceholders[i], barCells[i][0], barCells[i][1]);
+        }
         mainLayout->addWidget(verticalSplitter, 1, 1);
 
         q->setLayout(mainLayout);
@@ -396,115 +432,314 @@ namespace JBDS {
         dragCtl.reset(new DockDragController(q));
     }
 
-    void DockWidgetPrivate::barButtonAdded(Qt::Edge edge, Side side, QAbstractButton *button) {
-        auto panel = panels[edge2index(edge)];
-        auto data = buttonDataHash.value(button);
-        panel->addWidget(side, data.container, dockVisible(button));
+    DockSideBar *DockWidgetPrivate::sideBar(int index) {
+        Q_Q(DockWidget);
+        if (bars[index])
+            return bars[index];
+
+        static const char *const names[] = {"left-bar", "top-bar", "right-bar", "bottom-bar"};
+
+        auto bar = new DockSideBar(q, index2edge(index));
+        bar->setObjectName(names[index]);
+        bar->setPadding(barPadding);
+        bar->setButtonSpacing(buttonSpacing);
+        bar->setHighlightColor(highlightColor);
+        if (barHidden[index]) {
+            bar->hide();
+        }
+
+        // Take over the grid slot
+        mainLayout->removeItem(barPlaceholders[index]);
+        delete barPlaceholders[index];
+        barPlaceholders[index] = nullptr;
+        mainLayout->addWidget(bar, barCells[index][0], barCells[index][1]);
+
+        bars[index] = bar;
+        return bar;
     }
 
-    void DockWidgetPrivate::barButtonRemoved(Qt::Edge edge, Side side, QAbstractButton *button) {
-        auto panel = panels[edge2index(edge)];
-        auto data = buttonDataHash.value(button);
-        panel->removeWidget(side, data.container);
+    DockPanel *DockWidgetPrivate::panel(int index) {
+        if (panels[index])
+            return panels[index];
+
+        // Left and right panels stack their sides vertically
+        auto panel = new DockPanel((index % 2 == 0) ? Qt::Vertical : Qt::Horizontal);
+        auto splitter = (index % 2 == 0) ? horizontalSplitter : verticalSplitter;
+        if (index < 2) {
+            splitter->insertWidget(0, panel);
+        } else {
+            splitter->addWidget(panel);
+        }
+        splitter->setStretchFactor(splitter->indexOf(panel), 0);
+        connectSplitter(panel);
+        panel->installEventFilter(this);
+
+        panels[index] = panel;
+        return panel;
     }
 
-    void DockWidgetPrivate::moveWidgetToPos(QWidget *w, const QPoint &pos) {
-        w->move(pos);
-        adjustWindowGeometry(w);
+    QList<int> DockWidgetPrivate::splitterSizes(Qt::Orientation orientation) const {
+        int sizes[3];
+        splitterSizes(orientation, sizes);
+        return {sizes[0], sizes[1], sizes[2]};
     }
 
-    void DockWidgetPrivate::_q_widgetDestroyed() {
-        Q_Q(DockWidget);
-        q->removeWidget(widgetIndexes.value(static_cast<QWidget *>(sender())));
+    // What QSplitter::sizes() reports, read from the widgets instead of a new list
+    void DockWidgetPrivate::splitterSizes(Qt::Orientation orientation, int (&sizes)[3]) const {
+        bool horizontal = orientation == Qt::Horizontal;
+        auto extent = [horizontal](const QWidget *w) {
+            if (!w || w->isHidden())
+                return 0;
+            return horizontal ? w->width() : w->height();
+        };
+        int front = horizontal ? 0 : 1;
+        sizes[0] = extent(panels[front]);
+        sizes[1] = extent(horizontal ? static_cast<QWidget *>(centralContainer)
+                                     : static_cast<QWidget *>(horizontalSplitter));
+        sizes[2] = extent(panels[front + 2]);
     }
 
-    void DockWidgetPrivate::_q_buttonDestroyed() {
-        Q_Q(DockWidget);
-        q->removeWidget(static_cast<QAbstractButton *>(sender()));
+    void DockWidgetPrivate::setSplitterSizes(Qt::Orientation orientation, QList<int> sizes) {
+        int front = (orientation == Qt::Horizontal) ? 0 : 1;
+        if (sizes.size() == 3) {
+            if (!panels[front + 2]) {
+                sizes.removeLast();
+            }
+            if (!panels[front]) {
+                sizes.removeFirst();
+            }
+        }
+        (orientation == Qt::Horizontal ? horizontalSplitter : verticalSplitter)->setSizes(sizes);
+        counters.add(DockWidget::SplitterResizes);
     }
 
-    void DockWidgetPrivate::_q_buttonToggled(bool checked) {
-        Q_UNUSED(checked)
+    QList<DockSplitter *> DockWidgetPrivate::splitters() const {
+        QList<DockSplitter *> res = {horizontalSplitter, verticalSplitter};
+        for (auto panel : panels) {
+            if (panel)
+                res.append(panel);
+        }
+        return res;
+    }
 
-        auto button = static_cast<QAbstractButton *>(sender());
-        auto data = buttonDataHash.value(button);
+    void DockWidgetPrivate::connectSplitter(DockSplitter *splitter) {
+        splitter->setTuning(&resizeTuning);
+        splitter->setHandleColor(handleColor);
+        connect(splitter, &DockSplitter::handlePressed, this, &DockWidgetPrivate::freezeContents);
+        connect(splitter, &DockSplitter::handleReleased, this, &DockWidgetPrivate::thawContents);
+    }
 
-        // Transfer to sidebar
-        auto edgeIdx = edge2index(data.edge);
-        bars[edgeIdx]->buttonToggled(data.side, button);
+    void DockWidgetPrivate::freezeContents() {
+        finishTransition();
+        if (!snapshots.isEmpty())
+            return;
 
-        // Transfer to panel
-        auto panel = panels[edgeIdx];
-        bool visible = button->isChecked();
-        if (data.viewMode == DockPinned) {
-            panel->setContainerVisible(data.side, visible);
-            if (visible) {
-                panel->setCurrentWidget(data.side, data.container);
-            }
-        } else {
-            data.widget->setVisible(visible);
+        auto snapshotCounter = &counters.values[DockWidget::SnapshotFilterEvents];
+        if (attributes[DockWidget::FreezeCentralWhileResizing] && centralContainer->count() > 0) {
+            snapshots.append(DockContentSnapshot::freeze(centralContainer, snapshotCounter));
+        }
+        for (const auto &data : std::as_const(buttonDataHash)) {
+            if (!data.freezeWhileResizing || data.viewMode != DockPinned || !data.container ||
+                !data.container->isVisible())
+                continue;
+            snapshots.append(DockContentSnapshot::freeze(data.container, snapshotCounter));
         }
     }
 
-    DockWidget::DockWidget(QWidget *parent)
-        : DockWidget(*new DockWidgetPrivate(), new DefaultDockButtonDelegate(), parent) {
+    void DockWidgetPrivate::thawContents() {
+        for (const auto &snapshot : std::as_const(snapshots)) {
+            if (snapshot)
+                snapshot->thaw();
+        }
+        snapshots.clear();
     }
 
-    DockWidget::DockWidget(DockButtonDelegate *delegate, QWidget *parent)
-        : DockWidget(*new DockWidgetPrivate(), delegate, parent) {
+    bool DockWidgetPrivate::canAnimate() const {
+        Q_Q(const DockWidget);
+        return attributes[DockWidget::AnimatePanels] && animationDuration > 0 && batchDepth == 0 &&
+               q->isVisible();
     }
 
-    DockWidget::~DockWidget() {
+    void DockWidgetPrivate::startTransition(Qt::Orientation orientation, const QList<int> &from,
+                                            const QList<int> &to,
+                                            const std::function<void()> &finish) {
+        finishTransition();
+
+        transition.orientation = orientation;
+        transition.from = from;
+        transition.to = to;
+        transition.finish = finish;
+
+        // Pictures of what is there now, stretched by every frame
+        auto snapshotCounter = &counters.values[DockWidget::SnapshotFilterEvents];
+        if (centralContainer->count() > 0) {
+            transition.snapshots.append(
+                DockContentSnapshot::freeze(centralContainer, snapshotCounter));
+        }
+        int front = (orientation == Qt::Horizontal) ? 0 : 1;
+        for (int i : {front, front + 2}) {
+            auto panel = panels[i];
+            if (!panel || !panel->isVisible())
+                continue;
+            for (auto side : {Front, Back}) {
+                auto w = panel->currentWidget(side);
+                if (w && w->isVisible()) {
+                    transition.snapshots.append(DockContentSnapshot::freeze(w, snapshotCounter));
+                }
+            }
+
+            // Panels have to go below the minimum of their content while collapsing
+            transition.minimums.append({panel, panel->minimumSize()});
+            if (orientation == Qt::Horizontal) {
+                panel->setMinimumWidth(1);
+            } else {
+                panel->setMinimumHeight(1);
+            }
+        }
+        setSplitterSizes(orientation, from);
+
+        // Frames are computed from the elapsed time, late ones are skipped rather than queued
+        if (!transitionAnimation) {
+            transitionAnimation = new QVariantAnimation(this);
+            transitionAnimation->setStartValue(0.0);
+            transitionAnimation->setEndValue(1.0);
+            transitionAnimation->setEasingCurve(QEasingCurve::OutCubic);
+            connect(transitionAnimation, &QVariantAnimation::valueChanged, this,
+                    [this](const QVariant &value) {
+                        if (transitionAnimation->state() != QAbstractAnimation::Running)
+                            return;
+                        double t = value.toDouble();
+                        const auto &from = transition.from;
+                        const auto &to = transition.to;
+                        QList<int> sizes = {
+                            from[0] + qRound((to[0] - from[0]) * t),
+                            0,
+                            from[2] + qRound((to[2] - from[2]) * t),
+                        };
+                        sizes[1] = from[0] + from[1] + from[2] - sizes[0] - sizes[2];
+                        setSplitterSizes(transition.orientation, sizes);
+                    });
+            connect(transitionAnimation, &QAbstractAnimation::finished, this,
+                    &DockWidgetPrivate::finishTransition);
+        }
+        transitionAnimation->setDuration(animationDuration);
+        transitionAnimation->start();
     }
 
-    int DockWidget::resizeMargin() const {
-        Q_D(const DockWidget);
-        return d->resizeMargin;
+    void DockWidgetPrivate::finishTransition() {
+        if (transition.from.isEmpty())
+            return;
+
+        auto current = std::move(transition);
+        transition = {};
+        if (transitionAnimation) {
+            transitionAnimation->stop();
+        }
+
+        setSplitterSizes(current.orientation, current.to);
+        for (const auto &item : std::as_const(current.minimums)) {
+            if (item.first)
+                item.first->setMinimumSize(item.second);
+        }
+        if (current.finish) {
+            current.finish();
+        }
+
+        // The only layout of the contents
+        for (const auto &snapshot : std::as_const(current.snapshots)) {
+            if (snapshot)
+                snapshot->thaw();
+        }
     }
 
-    void DockWidget::setResizeMargin(int resizeMargin) {
-        Q_D(DockWidget);
-        d->resizeMargin = resizeMargin;
-        for (const auto &item : d->buttonDataHash) {
-            static_cast<QMFloatingWindowHelper *>(item.floatingHelper)
-                ->setResizeMargins({resizeMargin, resizeMargin, resizeMargin, resizeMargin});
+    DockLayoutEngine::Input DockWidgetPrivate::layoutInput() const {
+        Q_Q(const DockWidget);
+
+        DockLayoutEngine::Input input;
+        input.size = q->contentsRect().size();
+        for (int i = 0; i < 4; ++i) {
+            auto bar = bars[i];
+            if (bar && !bar->isHidden()) {
+                auto hint = bar->sizeHint();
+                input.barExtents[i] =
+                    (bar->orientation() == Qt::Horizontal) ? hint.height() : hint.width();
+            }
+
+            // Top and bottom panels live in the vertical splitter
+            auto panel = panels[i];
+            if (!panel)
+                continue;
+            bool vertical = i % 2 == 1;
+            auto minSize = panel->minimumSizeHint().expandedTo(panel->minimumSize());
+            auto &p = input.panels[i];
+            p.visible = !panel->isHidden();
+            p.minimum = vertical ? minSize.height() : minSize.width();
+            p.crossMinimum = vertical ? minSize.width() : minSize.height();
+            p.maximum = vertical ? panel->maximumHeight() : panel->maximumWidth();
+            p.size = vertical ? panel->height() : panel->width();
         }
+        input.centralMinimum =
+            centralContainer->minimumSizeHint().expandedTo(centralContainer->minimumSize());
+        input.handleWidth = verticalSplitter->handleWidth();
+        return input;
     }
 
-    QWidget *DockWidget::widget() const {
-        Q_D(const DockWidget);
-        return (d->centralContainer->count() == 0) ? nullptr : d->centralContainer->widget(0);
+    DockLayoutEngine::Result
+        DockWidgetPrivate::computeLayout(const DockLayoutEngine::Input &input) {
+        counters.add(DockWidget::Relayouts);
+        return DockLayoutEngine::compute(input);
     }
 
-    void DockWidget::setWidget(QWidget *w) {
-        Q_D(DockWidget);
-        if (d->centralContainer->count() > 0) {
-            delete takeWidget();
-        }
-        if (w) {
-            d->centralContainer->addWidget(w);
-        }
+    void DockWidgetPrivate::applySplitterSizes(Qt::Orientation orientation,
+                                               const DockLayoutEngine::Result &res) {
+        const auto &sizes =
+            (orientation == Qt::Horizontal) ? res.horizontalSizes : res.verticalSizes;
+        setSplitterSizes(orientation, {sizes[0], sizes[1], sizes[2]});
     }
 
-    QWidget *DockWidget::takeWidget() {
-        Q_D(DockWidget);
-        if (d->centralContainer->count() > 0) {
-            auto w = d->centralContainer->widget(0);
-            d->centralContainer->removeWidget(w);
-            return w;
+    void DockWidgetPrivate::resizeEdge(int index, int size) {
+        auto input = layoutInput();
+        input.panels[index].size = size;
+        input.priority = index;
+
+        if (index == 3) {
+            orgVSizes = splitterSizes(Qt::Vertical);
         }
-        return nullptr;
-    }
 
-    QAbstractButton *DockWidget::insertWidget(Qt::Edge edge, Side side, int index, QWidget *w) {
-        Q_D(DockWidget);
-        if (d->widgetIndexes.contains(w))
-            return nullptr;
+        auto res = computeLayout(input);
+        applySplitterSizes((index % 2 == 0) ? Qt::Horizontal : Qt::Vertical, res);
+    }
 
+    QAbstractButton *DockWidgetPrivate::createButton(Qt::Edge edge, Side side, const QString &id) {
         // Create button
-        auto button = d->delegate->create(nullptr);
+        auto button = delegate->create(nullptr);
         button->setCheckable(true);
 
+        DockButtonData data;
+        data.edge = edge;
+        data.side = side;
+        data.id = id;
+        data.title = button->text();
+        data.iconKey = button->icon().cacheKey();
+        data.buttonEventFilter = new ButtonEventFilter(this, nullptr, button, button);
+        if (search) {
+            search->insert(button, data.title.isEmpty() ? id : data.title, id);
+        }
+
+        // Add button data
+        buttonDataHash.insert(button, data);
+        registryGeneration++;
+
+        // Connect signals
+        connect(button, &QObject::destroyed, this, &DockWidgetPrivate::_q_buttonDestroyed);
+        connect(button, &QAbstractButton::toggled, this, &DockWidgetPrivate::_q_buttonToggled);
+        connect(button, &QAbstractButton::toggled, this,
+                &DockWidgetPrivate::_q_buttonVisibilityChanged);
+
+        return button;
+    }
+
+    void DockWidgetPrivate::attachWidget(QAbstractButton *button, QWidget *w) {
         // Create container
         QWidget *container;
         {
@@ -521,218 +756,1229 @@ namespace JBDS {
         }
 
         auto floatingHelper = new QMFloatingWindowHelper(w, container);
-        floatingHelper->setResizeMargins(
-            {d->resizeMargin, d->resizeMargin, d->resizeMargin, d->resizeMargin});
-
-        DockButtonData data{
-            DockPinned,
-            edge,
-            side,
-            w,
-            container,
-            floatingHelper,
-            new WidgetEventFilter(d, w, button, container),
-            new ButtonEventFilter(d, w, button, container),
-        };
-
-        // Add button data
-        d->buttonDataHash.insert(button, data);
-        d->widgetIndexes.insert(w, button);
+        floatingHelper->setEventCounter(&counters.values[DockWidget::FloatingFilterEvents]);
+        floatingHelper->setResizeMargins({resizeMargin, resizeMargin, resizeMargin, resizeMargin});
 
-        // Connect signals
-        connect(w, &QObject::destroyed, d, &DockWidgetPrivate::_q_widgetDestroyed);
-        connect(button, &QObject::destroyed, d, &DockWidgetPrivate::_q_buttonDestroyed);
-        connect(button, &QAbstractButton::toggled, d, &DockWidgetPrivate::_q_buttonToggled);
+        auto &data = buttonDataHash[button];
+        data.widget = w;
+        data.container = container;
+        data.floatingHelper = floatingHelper;
+        data.widgetEventFilter = new WidgetEventFilter(this, w, button, container);
 
-        // Insert button
-        d->bars[edge2index(edge)]->insertButton(data.side, index, button);
+        widgetIndexes.insert(w, button);
 
-        return button;
+        connect(w, &QObject::destroyed, this, &DockWidgetPrivate::_q_widgetDestroyed);
     }
 
-    void DockWidget::removeWidget(QAbstractButton *button) {
-        Q_D(DockWidget);
+    bool DockWidgetPrivate::materialize(QAbstractButton *button) {
+        Q_Q(DockWidget);
 
-        auto it = d->buttonDataHash.find(button);
-        if (it == d->buttonDataHash.end())
-            return;
+        auto it = buttonDataHash.find(button);
+        if (it == buttonDataHash.end())
+            return false;
+        if (it->widget)
+            return true;
+
+        auto id = it->id;
+        auto factory = it->factory;
+        auto w = factory ? factory() : nullptr;
+        if (!w) {
+            qCWarning(jbdsPerf, "Factory of tool window \"%s\" returned no widget",
+                      qPrintable(id));
+            return false;
+        }
+        if (widgetIndexes.contains(w)) {
+            qCWarning(jbdsPerf, "Factory of tool window \"%s\" returned a widget already docked",
+                      qPrintable(id));
+            return false;
+        }
 
+        // The factory may have touched the dock, look up again
+        it = buttonDataHash.find(button);
+        if (it == buttonDataHash.end()) {
+            if (!w->parentWidget())
+                delete w;
+            return false;
+        }
         auto &data = it.value();
-        auto w = data.widget;
-
-        // Make the widget independent
-        if (auto layout = data.container->layout(); layout->count() > 0) {
-            layout->removeWidget(layout->itemAt(0)->widget());
+        if (w->objectName().isEmpty()) {
+            w->setObjectName(data.id);
         }
 
-        // Remove button
-        d->bars[edge2index(data.edge)]->removeButton(data.side, button);
-
-        // Disconnect signals
-        disconnect(w, &QObject::destroyed, d, &DockWidgetPrivate::_q_widgetDestroyed);
-        disconnect(button, &QObject::destroyed, d, &DockWidgetPrivate::_q_buttonDestroyed);
-        disconnect(button, &QAbstractButton::toggled, d, &DockWidgetPrivate::_q_buttonToggled);
-
-        // Remove button and container
-        button->deleteLater();
-        data.container->deleteLater();
+        // View mode may have been chosen before the content existed
+        auto viewMode = data.viewMode;
+        data.viewMode = DockPinned;
+        attachWidget(button, w);
+        counters.add(DockWidget::ToolWindowsMaterialized);
 
-        // Remove button data
-        d->widgetIndexes.remove(w);
-        d->buttonDataHash.erase(it);
+        auto newData = buttonDataHash.value(button);
+        panel(edge2index(newData.edge))->addWidget(newData.side, newData.container, false);
+        if (viewMode != DockPinned) {
+            q->setViewMode(button, viewMode);
+        }
+        return true;
     }
 
-    void DockWidget::moveWidget(QAbstractButton *button, Qt::Edge edge, Side side, int index) {
-        Q_D(DockWidget);
-
-        auto it = d->buttonDataHash.find(button);
-        if (it == d->buttonDataHash.end())
-            return;
-
-        auto &data = it.value();
-        auto orgBar = d->bars[edge2index(data.edge)];
-        auto newBar = d->bars[edge2index(edge)];
+    const QHash<QString, QAbstractButton *> &DockWidgetPrivate::buttonsById() const {
+        if (idCacheGeneration == registryGeneration) {
+            return idCache;
+        }
 
-        orgBar->removeButton(data.side, button);
-        data.edge = edge;
-        data.side = side;
-        newBar->insertButton(side, index, button);
+        idCache.clear();
+        idCache.reserve(buttonDataHash.size());
+        for (auto bar : bars) {
+            if (!bar)
+                continue;
+            for (auto side : {Front, Back}) {
+                const auto &buttons = bar->buttons(side);
+                for (auto button : buttons) {
+                    const auto &id = buttonData(button).id;
+                    if (!id.isEmpty() && !idCache.contains(id)) {
+                        idCache.insert(id, button);
+                    }
+                }
+            }
+        }
+        idCacheGeneration = registryGeneration;
+        return idCache;
     }
 
-    int DockWidget::widgetCount(Qt::Edge edge, Side side) const {
-        Q_D(const DockWidget);
-        return d->bars[edge2index(edge)]->count(side);
+    // Resolves the layout against the registry once, unknown and repeated ids are dropped
+    DockLayout DockWidgetPrivate::compileLayout(const DockLayout &layout) const {
+        const auto &buttons = buttonsById();
+
+        DockLayout res;
+        QSet<QString> seen;
+        for (int i = 0; i < 4; ++i) {
+            for (auto side : {Front, Back}) {
+                auto items = layout.items(index2edge(i), side);
+                QList<DockLayout::Item> compiled;
+                compiled.reserve(items.size());
+                for (const auto &item : std::as_const(items)) {
+                    if (!buttons.contains(item.id) || seen.contains(item.id))
+                        continue;
+                    seen.insert(item.id);
+                    compiled.append(item);
+                }
+                res.setItems(index2edge(i), side, compiled);
+            }
+        }
+        res.setOrientationSizes(Qt::Horizontal, layout.orientationSizes(Qt::Horizontal));
+        res.setOrientationSizes(Qt::Vertical, layout.orientationSizes(Qt::Vertical));
+        return res;
     }
 
-    QList<QWidget *> DockWidget::widgets(Qt::Edge edge, Side side) const {
-        Q_D(const DockWidget);
-
-        auto buttons = d->bars[edge2index(edge)]->buttons(side);
-        QList<QWidget *> res;
-        res.reserve(buttons.size());
-        for (const auto &button : std::as_const(buttons)) {
-            res.append(d->buttonDataHash.value(button).widget);
+    void DockWidgetPrivate::barButtonAdded(Qt::Edge edge, Side side, QAbstractButton *button) {
+        auto container = buttonData(button).container;
+        if (!container) {
+            return;
         }
-        return res;
+        panel(edge2index(edge))->addWidget(side, container, dockVisible(button));
     }
 
-    QWidget *DockWidget::widget(const QAbstractButton *button) {
-        Q_D(const DockWidget);
-        return d->buttonDataHash.value(const_cast<QAbstractButton *>(button)).widget;
+    void DockWidgetPrivate::barButtonRemoved(Qt::Edge edge, Side side, QAbstractButton *button) {
+        auto container = buttonData(button).container;
+        if (!container) {
+            return;
+        }
+        panels[edge2index(edge)]->removeWidget(side, container);
     }
 
-    ViewMode DockWidget::viewMode(const QAbstractButton *button) {
-        Q_D(const DockWidget);
-        return d->buttonDataHash.value(const_cast<QAbstractButton *>(button)).viewMode;
+    void DockWidgetPrivate::moveWidgetToPos(QWidget *w, const QPoint &pos) {
+        w->move(pos);
+        adjustWindowGeometry(w);
     }
 
-    void DockWidget::setViewMode(QAbstractButton *button, ViewMode viewMode) {
-        Q_D(DockWidget);
-        auto it = d->buttonDataHash.find(button);
-        if (it == d->buttonDataHash.end())
-            return;
+    void DockWidgetPrivate::beginBatch() {
+        batchDepth++;
+    }
 
-        auto &data = it.value();
-        auto oldViewMode = data.viewMode;
-        if (oldViewMode == viewMode) {
+    // The layouts of the scope and of its direct children, tool window contents and windows
+    // keep theirs
+    void DockWidgetPrivate::addToBatch(QWidget *scope) {
+        if (batchDepth == 0 || !scope)
             return;
+        for (const auto &it : std::as_const(batchScopes)) {
+            if (it.widget == scope)
+                return;
         }
 
-        auto widget = data.widget;
-        auto container = data.container;
-        auto edgeIdx = edge2index(data.edge);
-        const auto &oldGeometry =
-            static_cast<WidgetEventFilter *>(data.widgetEventFilter)->oldGeometry;
-        auto floatingHelper = static_cast<QMFloatingWindowHelper *>(data.floatingHelper);
-        auto asWindow = [&](const QSize &size, const QPoint &extraOffset) {
-            // Size
-            if (!size.isEmpty()) {
-                widget->resize(size);
-            } else if (!oldGeometry.isEmpty()) {
-                widget->resize(oldGeometry.size());
+        BatchScope res;
+        res.widget = scope;
+        res.updatesEnabled = scope->updatesEnabled();
+
+        auto owners = scope->findChildren<QWidget *>(Qt::FindDirectChildrenOnly);
+        owners.append(scope);
+        for (auto w : std::as_const(owners)) {
+            if (w->isWindow() && w != scope)
+                continue;
+            if (widgetIndexes.contains(w))
+                continue;
+            auto layout = w->layout();
+            if (layout && layout->isEnabled()) {
+                layout->setEnabled(false);
+                res.layouts.append(layout);
             }
+        }
+        if (res.updatesEnabled) {
+            scope->setUpdatesEnabled(false);
+        }
+        batchScopes.append(res);
+    }
 
-            // Pos
-            if (!oldGeometry.isEmpty()) {
-                widget->move(oldGeometry.topLeft() - extraOffset);
-            } else {
-                QPoint offset;
-                switch (data.edge) {
-                    case Qt::TopEdge:
-                        offset.ry() += button->height();
-                        break;
-                    case Qt::BottomEdge:
-                        offset.ry() -= button->height() + size.height();
-                        break;
-                    case Qt::LeftEdge:
-                        offset.rx() += button->width();
-                        break;
-                    case Qt::RightEdge:
-                        offset.rx() -= button->width() + size.width();
-                        break;
-                }
+    void DockWidgetPrivate::endBatch() {
+        if (--batchDepth > 0)
+            return;
 
-                DockWidgetPrivate::moveWidgetToPos(widget, button->mapToGlobal(QPoint()) + offset -
-                                                               extraOffset);
+        auto scopes = std::move(batchScopes);
+        batchScopes.clear();
+
+        // Scopes added later lie inside earlier ones, their size hints are settled first
+        for (auto it = scopes.crbegin(); it != scopes.crend(); ++it) {
+            for (const auto &layout : it->layouts) {
+                if (!layout)
+                    continue;
+                layout->setEnabled(true);
+                layout->invalidate();
+                layout->activate();
+            }
+        }
+        for (const auto &scope : std::as_const(scopes)) {
+            if (scope.widget && scope.updatesEnabled) {
+                scope.widget->setUpdatesEnabled(true);
             }
+        }
+    }
 
-            widget->setVisible(button->isChecked());
-        };
+    void DockWidgetPrivate::applyLayoutOperation(const DockLayoutOperation &op,
+                                                 const QHash<QString, QAbstractButton *> &buttons) {
+        Q_Q(DockWidget);
 
-        auto layout = container->layout();
-        switch (viewMode) {
-            case DockPinned: {
-                floatingHelper->setFloating(false);
-                widget->setWindowFlags(Qt::Widget);
-                layout->addWidget(widget);
-                widget->setVisible(true);
+        if (op.type == DockLayoutOperation::SetSizes) {
+            q->setOrientationSizes(op.orientation, op.sizes);
+            return;
+        }
 
-                // Restore sizes
-                if (!oldGeometry.isEmpty()) {
-                    auto sideBar = d->bars[edgeIdx];
-                    auto size = oldGeometry.size();
-                    QTimer::singleShot(0, this, [viewMode, this, widget, sideBar, size]() {
-                        switch (viewMode) {
-                            case DockPinned: {
-                                if (sideBar->orientation() == Qt::Horizontal) {
-                                    setEdgeSize(sideBar->edge(), size.height());
-                                } else {
-                                    setEdgeSize(sideBar->edge(), size.width());
-                                }
-                                break;
-                            }
-                            default: {
-                                widget->resize(size);
-                                break;
-                            }
+        auto button = buttons.value(op.id);
+        if (!button)
+            return;
+
+        switch (op.type) {
+            case DockLayoutOperation::Hide:
+            case DockLayoutOperation::Show: {
+                button->setChecked(op.type == DockLayoutOperation::Show);
+                break;
+            }
+            case DockLayoutOperation::Move: {
+                auto bar = sideBar(edge2index(op.edge));
+                int index = 0;
+                if (auto after = buttons.value(op.afterId)) {
+                    index = bar->indexOf(op.side, after) + 1;
+
+                    // Removing the button first shifts the anchor to the front
+                    const auto &data = buttonData(button);
+                    if (data.edge == op.edge && data.side == op.side) {
+                        int cur = bar->indexOf(op.side, button);
+                        if (cur >= 0 && cur < index) {
+                            index--;
                         }
-                    });
+                    }
                 }
+                q->moveWidget(button, op.edge, op.side, index);
                 break;
             }
+            case DockLayoutOperation::SetViewMode: {
+                q->setViewMode(button, op.viewMode);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void DockWidgetPrivate::_q_widgetDestroyed() {
+        Q_Q(DockWidget);
+        q->removeWidget(widgetIndexes.value(static_cast<QWidget *>(sender())));
+    }
+
+    void DockWidgetPrivate::_q_buttonDestroyed() {
+        Q_Q(DockWidget);
+        q->removeWidget(static_cast<QAbstractButton *>(sender()));
+    }
+
+    // Connected after the one above, the tool window is shown or hidden by now
+    void DockWidgetPrivate::_q_buttonVisibilityChanged(bool checked) {
+        Q_Q(DockWidget);
+        auto button = static_cast<QAbstractButton *>(sender());
+
+        // Unchecked again because its content could not be created
+        if (checked != button->isChecked() || !buttonDataHash.contains(button))
+            return;
+        if (checked) {
+            touchRecent(button);
+        }
+        addChange(button, VisibilityChanged);
+        emit q->visibilityChanged(button, checked);
+    }
+
+    void DockWidgetPrivate::_q_buttonToggled(bool checked) {
+        Q_UNUSED(checked)
+        JBDS_TRACE_SCOPE("DockWidgetPrivate::buttonToggled");
+
+        auto button = static_cast<QAbstractButton *>(sender());
+        if (button->isChecked() && !buttonData(button).widget && !materialize(button)) {
+            // Nothing to show, or removed by the factory
+            if (buttonDataHash.contains(button)) {
+                QSignalBlocker blocker(button);
+                button->setChecked(false);
+            }
+            return;
+        }
+        auto data = buttonDataHash.value(button);
+
+        // Transfer to sidebar
+        auto edgeIdx = edge2index(data.edge);
+        bars[edgeIdx]->buttonToggled(data.side, button);
+
+        // Transfer to panel
+        auto panel = panels[edgeIdx];
+        bool visible = button->isChecked();
+        if (data.viewMode == DockPinned) {
+            if (!data.container)
+                return;
+            finishTransition();
+
+            // Switching tabs, the tool window being checked takes the place right away
+            if (!visible) {
+                for (auto cur : bars[edgeIdx]->buttons(data.side)) {
+                    if (cur != button && dockVisible(cur))
+                        return;
+                }
+            }
+
+            // Animate only when the whole panel appears or disappears
+            auto otherSide = (data.side == Front) ? Back : Front;
+            auto other = panel->currentWidget(otherSide);
+            bool alone = !other || !other->parentWidget()->isVisible();
+            if (canAnimate() && alone && visible != panel->isVisible()) {
+                auto orientation = (edgeIdx % 2 == 0) ? Qt::Horizontal : Qt::Vertical;
+                int slot = (edgeIdx < 2) ? 0 : 2;
+                if (visible) {
+                    // Lay out the panel at its final size once, then grow it from nothing
+                    panel->setContainerVisible(data.side, true);
+                    panel->setCurrentWidget(data.side, data.container);
+                    applySplitterSizes(orientation, computeLayout(layoutInput()));
+
+                    auto to = splitterSizes(orientation);
+                    auto from = to;
+                    from[1] += from[slot] - 1;
+                    from[slot] = 1;
+                    startTransition(orientation, from, to);
+                } else {
+                    auto from = splitterSizes(orientation);
+                    auto to = from;
+                    to[1] += to[slot] - 1;
+                    to[slot] = 1;
+
+                    // Hidden for real at the end, reopening gets the former size back
+                    auto side = data.side;
+                    startTransition(orientation, from, to, [this, orientation, from, panel, side]() {
+                        setSplitterSizes(orientation, from);
+                        panel->setContainerVisible(side, false);
+                    });
+                }
+                return;
+            }
+
+            panel->setContainerVisible(data.side, visible);
+            if (visible) {
+                panel->setCurrentWidget(data.side, data.container);
+            }
+        } else if (data.viewMode == Undocked) {
+            if (!data.widget)
+                return;
+            if (visible) {
+                // One overlay per stripe, like pinned tool windows
+                // Copied, unchecking runs the slots of the application
+                const auto cards = bars[edgeIdx]->buttons(data.side);
+                for (auto cur : cards) {
+                    if (cur != button && cur->isChecked() &&
+                        buttonData(cur).viewMode == Undocked) {
+                        cur->setChecked(false);
+                    }
+                }
+                data.widget->setGeometry(overlayGeometry(data));
+                data.widget->show();
+                data.widget->raise();
+                data.widget->setFocus(Qt::OtherFocusReason);
+            } else {
+                data.widget->hide();
+            }
+        } else if (data.widget) {
+            auto window = detachedWindow(data);
+            setWindowVisible(window, visible);
+
+            // May be inside the hide event of a closing window, wait until it returns
+            if (!visible && data.windowPolicy == DockWidget::DestroyWindowOnHide) {
+                QTimer::singleShot(0, window, [this, window]() {
+                    releaseNativeWindow(window); //
+                });
+            }
+        }
+    }
+
+    void DockWidgetPrivate::_q_focusChanged(QWidget *old, QWidget *now) {
+        Q_UNUSED(old)
+
+        // Focus left the application or went to a popup, e.g. a context menu
+        if (!now || now->window()->windowType() == Qt::Popup)
+            return;
+
+        // Collected first, unchecking runs the slots of the application
+        QList<QAbstractButton *> outside;
+        for (auto it = buttonDataHash.cbegin(); it != buttonDataHash.cend(); ++it) {
+            const auto &data = it.value();
+            if (data.viewMode != Undocked || !data.widget || !data.widget->isVisible())
+                continue;
+            if (now == it.key() || data.widget->isAncestorOf(now) || now == data.widget)
+                continue;
+            outside.append(it.key());
+        }
+        QPointer<QWidget> focused(now);
+        for (auto button : std::as_const(outside)) {
+            if (buttonDataHash.contains(button)) {
+                button->setChecked(false);
+            }
+        }
+
+        // The tool window holding the focus, if any
+        for (auto w = focused.data(); w; w = w->parentWidget()) {
+            if (auto button = widgetIndexes.value(w)) {
+                touchRecent(button);
+                break;
+            }
+            if (w == q_ptr)
+                break;
+        }
+    }
+
+    void DockWidgetPrivate::updateHud() {
+        if (!hud || hud->isHidden())
+            return;
+        auto area = verticalSplitter->geometry();
+        hud->move(area.right() + 1 - hud->width() - 8, area.top() + 8);
+        hud->raise();
+    }
+
+    QWidget *DockWidgetPrivate::windowHost(QAbstractButton *button, ViewMode viewMode) {
+        Q_Q(DockWidget);
+
+        auto &data = buttonDataHash[button];
+        auto &host = data.hosts[viewMode == Window ? 1 : 0];
+        if (host)
+            return host;
+
+        // The flags never change afterwards, so the native window survives every switch
+        if (viewMode == Window) {
+            host = new QWidget(nullptr, Qt::Window);
+        } else {
+            host = new QWidget(q);
+            auto floatingHelper = new QMFloatingWindowHelper(host, host);
+            floatingHelper->setEventCounter(&counters.values[DockWidget::FloatingFilterEvents]);
+            floatingHelper->setResizeMargins(
+                {resizeMargin, resizeMargin, resizeMargin, resizeMargin});
+            floatingHelper->setFloating(true, Qt::Tool);
+        }
+        host->setObjectName("dock-window-host");
+
+        auto layout = new QVBoxLayout();
+        layout->setContentsMargins({});
+        layout->setSpacing(0);
+        host->setLayout(layout);
+
+        host->installEventFilter(data.widgetEventFilter);
+        return host;
+    }
+
+    QWidget *DockWidgetPrivate::detachedWindow(const DockButtonData &data) {
+        auto parent = data.widget->parentWidget();
+        if (parent && (parent == data.hosts[0] || parent == data.hosts[1]))
+            return parent;
+        return data.widget;
+    }
+
+    void DockWidgetPrivate::setWindowVisible(QWidget *window, bool visible) {
+        bool created = window->testAttribute(Qt::WA_WState_Created);
+        window->setVisible(visible);
+        if (!created && window->testAttribute(Qt::WA_WState_Created)) {
+            counters.add(DockWidget::NativeWindowsCreated);
+        }
+    }
+
+    // A top level widget becoming a child gives its native window back, unless it asked
+    // for one. It becomes a window again right away and gets a new one when next shown.
+    void DockWidgetPrivate::releaseNativeWindow(QWidget *w) {
+        Q_Q(DockWidget);
+        if (!w->isWindow() || !w->isHidden() || !w->testAttribute(Qt::WA_WState_Created) ||
+            w->testAttribute(Qt::WA_NativeWindow))
+            return;
+
+        auto parent = w->parentWidget();
+        auto flags = w->windowFlags();
+        auto geometry = w->geometry();
+        w->setParent(parent ? parent : q, flags & ~Qt::WindowType_Mask);
+        w->setParent(parent, flags);
+        w->setGeometry(geometry);
+        if (!w->testAttribute(Qt::WA_WState_Created)) {
+            counters.add(DockWidget::NativeWindowsReleased);
+        }
+    }
+
+    QRect DockWidgetPrivate::overlayGeometry(const DockButtonData &data) const {
+        auto area = verticalSplitter->geometry();
+        bool vertical = data.edge == Qt::TopEdge || data.edge == Qt::BottomEdge;
+        int length = vertical ? area.height() : area.width();
+        int extent = qMin(data.overlayExtent > 0 ? data.overlayExtent : length / 3, length);
+
+        switch (data.edge) {
+            case Qt::LeftEdge:
+                return {area.left(), area.top(), extent, area.height()};
+            case Qt::TopEdge:
+                return {area.left(), area.top(), area.width(), extent};
+            case Qt::RightEdge:
+                return {area.right() - extent + 1, area.top(), extent, area.height()};
+            case Qt::BottomEdge:
+                return {area.left(), area.bottom() - extent + 1, area.width(), extent};
+        }
+        return {};
+    }
+
+    void DockWidgetPrivate::updateOverlays() {
+        for (const auto &data : std::as_const(buttonDataHash)) {
+            if (data.viewMode != Undocked || !data.widget || !data.widget->isVisible())
+                continue;
+            data.widget->setGeometry(overlayGeometry(data));
+        }
+    }
+
+    void DockWidgetPrivate::addChange(QAbstractButton *button, Change change) {
+        auto &changes = pendingChanges;
+        auto &kinds = pendingKinds[button];
+        if (change == ToolWindowRemoved) {
+            changes.moved.removeOne(button);
+            changes.viewModeChanged.removeOne(button);
+            changes.visibilityChanged.removeOne(button);
+            changes.appearanceChanged.removeOne(button);
+
+            // Came and went within the batch, or the address of a removed one was reused
+            bool transient = kinds & ToolWindowAdded;
+            if (transient) {
+                changes.added.removeOne(button);
+            } else if (!(kinds & ToolWindowRemoved)) {
+                changes.removed.append(button);
+            }
+            kinds = transient ? (kinds & ToolWindowRemoved) : int(ToolWindowRemoved);
+            postChanges();
+            return;
+        }
+
+        if (kinds & change)
+            return;
+        kinds |= change;
+        switch (change) {
+            case ToolWindowAdded:
+                changes.added.append(button);
+                break;
+            case ToolWindowMoved:
+                changes.moved.append(button);
+                break;
+            case ViewModeChanged:
+                changes.viewModeChanged.append(button);
+                break;
+            case VisibilityChanged:
+                changes.visibilityChanged.append(button);
+                break;
+            case AppearanceChanged:
+                changes.appearanceChanged.append(button);
+                break;
+            default:
+                break;
+        }
+        postChanges();
+    }
+
+    bool DockWidgetPrivate::appearanceOutdated(const QAbstractButton *button) const {
+        const auto &data = buttonData(button);
+        return !data.appearanceSeen || data.title != button->text() ||
+               data.iconKey != button->icon().cacheKey();
+    }
+
+    void DockWidgetPrivate::updateAppearance(QAbstractButton *button) {
+        Q_Q(DockWidget);
+        auto it = buttonDataHash.find(button);
+        if (it == buttonDataHash.end() || !appearanceOutdated(button))
+            return;
+        bool seen = it->appearanceSeen;
+        it->appearanceSeen = true;
+        it->title = button->text();
+        it->iconKey = button->icon().cacheKey();
+        if (search) {
+            search->insert(button, it->title.isEmpty() ? it->id : it->title, it->id);
+        }
+
+        // The text and icon set right after adding the tool window
+        if (!seen)
+            return;
+        addChange(button, AppearanceChanged);
+        emit q->appearanceChanged(button);
+    }
+
+    void DockWidgetPrivate::touchRecent(QAbstractButton *button) {
+        if (recentHead == button)
+            return;
+        auto it = buttonDataHash.find(button);
+        if (it == buttonDataHash.end())
+            return;
+
+        unlinkRecent(button, it.value());
+        it->recentNext = recentHead;
+        if (recentHead) {
+            buttonDataHash.find(recentHead)->recentPrev = button;
+        }
+        recentHead = button;
+    }
+
+    void DockWidgetPrivate::unlinkRecent(QAbstractButton *button, DockButtonData &data) {
+        if (data.recentPrev) {
+            buttonDataHash.find(data.recentPrev)->recentNext = data.recentNext;
+        } else if (recentHead == button) {
+            recentHead = data.recentNext;
+        } else {
+            return; // Never activated
+        }
+        if (data.recentNext) {
+            buttonDataHash.find(data.recentNext)->recentPrev = data.recentPrev;
+        }
+        data.recentPrev = nullptr;
+        data.recentNext = nullptr;
+    }
+
+    // The last listed goes first so that the first ends up at the head
+    void DockWidgetPrivate::restoreRecent(const QStringList &ids) {
+        if (ids.isEmpty())
+            return;
+        const auto &buttons = buttonsById();
+        for (auto it = ids.crbegin(); it != ids.crend(); ++it) {
+            if (auto button = buttons.value(*it))
+                touchRecent(button);
+        }
+    }
+
+    void DockWidgetPrivate::updateAppearances() {
+        // Collected first, the receivers may change the dock
+        QList<QAbstractButton *> outdated;
+        for (auto it = buttonDataHash.constBegin(); it != buttonDataHash.constEnd(); ++it) {
+            if (appearanceOutdated(it.key()))
+                outdated.append(it.key());
+        }
+        for (auto button : std::as_const(outdated)) {
+            updateAppearance(button);
+        }
+    }
+
+    DockSearchIndex *DockWidgetPrivate::searchIndex() {
+        if (!search) {
+            search.reset(new DockSearchIndex());
+            for (auto it = buttonDataHash.constBegin(); it != buttonDataHash.constEnd(); ++it) {
+                search->insert(it.key(), it->title.isEmpty() ? it->id : it->title, it->id);
+            }
+        }
+        return search.data();
+    }
+
+    void DockWidgetPrivate::edgeResized(int index) {
+        Q_Q(DockWidget);
+        auto edge = index2edge(index);
+        int size = q->edgeSize(edge);
+        if (size == reportedEdgeSizes[index])
+            return;
+        reportedEdgeSizes[index] = size;
+
+        if (!pendingChanges.edgeSizeChanged.contains(edge)) {
+            pendingChanges.edgeSizeChanged.append(edge);
+        }
+        postChanges();
+        emit q->edgeSizeChanged(edge, size);
+    }
+
+    void DockWidgetPrivate::postChanges() {
+        if (changesPosted)
+            return;
+        changesPosted = true;
+
+        // A posted call, every change made until control returns to the loop joins the batch
+        QMetaObject::invokeMethod(this, &DockWidgetPrivate::flushChanges, Qt::QueuedConnection);
+    }
+
+    void DockWidgetPrivate::flushChanges() {
+        Q_Q(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidgetPrivate::flushChanges");
+
+        // Changes made by the receivers start the next batch
+        DockWidget::ChangeSet changes;
+        std::swap(changes, pendingChanges);
+        pendingKinds.clear();
+        changesPosted = false;
+        if (!changes.isEmpty()) {
+            emit q->layoutChanged(changes);
+        }
+    }
+
+    bool DockWidgetPrivate::eventFilter(QObject *obj, QEvent *event) {
+        counters.add(DockWidget::DockFilterEvents);
+        if (obj == verticalSplitter) {
+            switch (event->type()) {
+                case QEvent::Move:
+                case QEvent::Resize:
+                    updateOverlays();
+                    updateHud();
+                    break;
+                default:
+                    break;
+            }
+        } else if (event->type() == QEvent::Resize) {
+            for (int i = 0; i < 4; ++i) {
+                if (obj == panels[i]) {
+                    edgeResized(i);
+                    break;
+                }
+            }
+        }
+        return QObject::eventFilter(obj, event);
+    }
+
+    DockWidget::DockWidget(QWidget *parent)
+        : DockWidget(*new DockWidgetPrivate(), new DefaultDockButtonDelegate(), parent) {
+    }
+
+    DockWidget::DockWidget(DockButtonDelegate *delegate, QWidget *parent)
+        : DockWidget(*new DockWidgetPrivate(), delegate, parent) {
+    }
+
+    DockWidget::~DockWidget() {
+    }
+
+    int DockWidget::resizeMargin() const {
+        Q_D(const DockWidget);
+        return d->resizeMargin;
+    }
+
+    void DockWidget::setResizeMargin(int resizeMargin) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setResizeMargin");
+        d->resizeMargin = resizeMargin;
+        for (const auto &item : d->buttonDataHash) {
+            if (!item.floatingHelper)
+                continue;
+            static_cast<QMFloatingWindowHelper *>(item.floatingHelper)
+                ->setResizeMargins({resizeMargin, resizeMargin, resizeMargin, resizeMargin});
+            if (auto host = item.hosts[0]) {
+                host->findChild<QMFloatingWindowHelper *>(QString(), Qt::FindDirectChildrenOnly)
+                    ->setResizeMargins({resizeMargin, resizeMargin, resizeMargin, resizeMargin});
+            }
+        }
+    }
+
+    int DockWidget::barPadding() const {
+        Q_D(const DockWidget);
+        return d->barPadding;
+    }
+
+    void DockWidget::setBarPadding(int padding) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setBarPadding");
+        d->barPadding = padding;
+        for (auto bar : d->bars) {
+            if (bar)
+                bar->setPadding(padding);
+        }
+    }
+
+    int DockWidget::buttonSpacing() const {
+        Q_D(const DockWidget);
+        return d->buttonSpacing;
+    }
+
+    void DockWidget::setButtonSpacing(int spacing) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setButtonSpacing");
+        d->buttonSpacing = spacing;
+        for (auto bar : d->bars) {
+            if (bar)
+                bar->setButtonSpacing(spacing);
+        }
+    }
+
+    QColor DockWidget::highlightColor() const {
+        Q_D(const DockWidget);
+        return d->highlightColor;
+    }
+
+    void DockWidget::setHighlightColor(const QColor &color) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setHighlightColor");
+        d->highlightColor = color;
+        for (auto bar : d->bars) {
+            if (bar)
+                bar->setHighlightColor(color);
+        }
+    }
+
+    QColor DockWidget::handleColor() const {
+        Q_D(const DockWidget);
+        return d->handleColor;
+    }
+
+    void DockWidget::setHandleColor(const QColor &color) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setHandleColor");
+        d->handleColor = color;
+        for (auto splitter : d->splitters()) {
+            splitter->setHandleColor(color);
+        }
+    }
+
+    QWidget *DockWidget::widget() const {
+        Q_D(const DockWidget);
+        return (d->centralContainer->count() == 0) ? nullptr : d->centralContainer->widget(0);
+    }
+
+    void DockWidget::setWidget(QWidget *w) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setWidget");
+        if (d->centralContainer->count() > 0) {
+            delete takeWidget();
+        }
+        if (w) {
+            d->centralContainer->addWidget(w);
+        }
+    }
+
+    QWidget *DockWidget::takeWidget() {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::takeWidget");
+        if (d->centralContainer->count() > 0) {
+            auto w = d->centralContainer->widget(0);
+            d->centralContainer->removeWidget(w);
+            return w;
+        }
+        return nullptr;
+    }
+
+    QAbstractButton *DockWidget::insertWidget(Qt::Edge edge, Side side, int index, QWidget *w) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::insertWidget");
+        if (d->widgetIndexes.contains(w))
+            return nullptr;
+
+        auto button = d->createButton(edge, side, w->objectName());
+        d->attachWidget(button, w);
+
+        // Insert button
+        d->sideBar(edge2index(edge))->insertButton(side, index, button);
+
+        d->addChange(button, DockWidgetPrivate::ToolWindowAdded);
+        emit toolWindowAdded(button);
+        return button;
+    }
+
+    QAbstractButton *DockWidget::insertWidget(Qt::Edge edge, Side side, int index,
+                                              const QString &id, const WidgetFactory &factory) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::insertWidget");
+        if (!factory)
+            return nullptr;
+
+        auto button = d->createButton(edge, side, id);
+        d->buttonDataHash[button].factory = factory;
+
+        // Insert button, the content is created when it's shown for the first time
+        d->sideBar(edge2index(edge))->insertButton(side, index, button);
+
+        d->addChange(button, DockWidgetPrivate::ToolWindowAdded);
+        emit toolWindowAdded(button);
+        return button;
+    }
+
+    void DockWidget::removeWidget(QAbstractButton *button) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::removeWidget");
+
+        auto it = d->buttonDataHash.find(button);
+        if (it == d->buttonDataHash.end())
+            return;
+
+        auto &data = it.value();
+        auto w = data.widget;
+
+        // Make the widget independent
+        if (w) {
+            if (auto layout = data.container->layout(); layout->count() > 0) {
+                layout->removeWidget(layout->itemAt(0)->widget());
+            }
+            if (detachedWindow(data) != w) {
+                w->setParent(nullptr);
+            }
+        }
+        d->retiredWidgets.removeAll(nullptr);
+        for (auto host : data.hosts) {
+            if (host) {
+                host->deleteLater();
+                d->retiredWidgets.append(host);
+            }
+        }
+
+        // Remove button
+        d->bars[edge2index(data.edge)]->removeButton(data.side, button);
+
+        // Disconnect signals
+        if (w) {
+            disconnect(w, &QObject::destroyed, d, &DockWidgetPrivate::_q_widgetDestroyed);
+        }
+        disconnect(button, &QObject::destroyed, d, &DockWidgetPrivate::_q_buttonDestroyed);
+        disconnect(button, &QAbstractButton::toggled, d, &DockWidgetPrivate::_q_buttonToggled);
+        disconnect(button, &QAbstractButton::toggled, d,
+                   &DockWidgetPrivate::_q_buttonVisibilityChanged);
+
+        // Remove button and container
+        button->deleteLater();
+        if (data.container) {
+            data.container->deleteLater();
+            d->retiredWidgets.append(data.container);
+        }
+
+        // Remove button data
+        if (w) {
+            d->widgetIndexes.remove(w);
+        }
+        d->unlinkRecent(button, data);
+        d->buttonDataHash.erase(it);
+        d->registryGeneration++;
+        if (d->search) {
+            d->search->remove(button);
+        }
+
+        // May be called from the destructor of the button
+        d->addChange(button, DockWidgetPrivate::ToolWindowRemoved);
+        emit toolWindowRemoved(button);
+    }
+
+    void DockWidget::moveWidget(QAbstractButton *button, Qt::Edge edge, Side side, int index) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::moveWidget");
+
+        auto it = d->buttonDataHash.find(button);
+        if (it == d->buttonDataHash.end())
+            return;
+
+        auto &data = it.value();
+        auto orgBar = d->bars[edge2index(data.edge)];
+        auto newBar = d->sideBar(edge2index(edge));
+
+        // Same stripe, no need to take the container out of its panel
+        if (orgBar == newBar && data.side == side && orgBar->indexOf(side, button) >= 0) {
+            orgBar->moveButton(side, index, button);
+        } else {
+            orgBar->removeButton(data.side, button);
+            data.edge = edge;
+            data.side = side;
+            newBar->insertButton(side, index, button);
+
+            if (data.viewMode == Undocked && data.widget) {
+                data.widget->setGeometry(d->overlayGeometry(data));
+            }
+        }
+
+        d->addChange(button, DockWidgetPrivate::ToolWindowMoved);
+        emit toolWindowMoved(button, edge, side, newBar->indexOf(side, button));
+    }
+
+    int DockWidget::widgetCount(Qt::Edge edge, Side side) const {
+        Q_D(const DockWidget);
+        auto bar = d->bars[edge2index(edge)];
+        return bar ? bar->count(side) : 0;
+    }
 
-            case Floating: {
-                auto size = widget->size();
-                auto extraOffset = oldViewMode == DockPinned
-                                       ? QPoint()
-                                       : (widget->mapToGlobal(QPoint()) - widget->pos());
+    QList<QWidget *> DockWidget::widgets(Qt::Edge edge, Side side) const {
+        Q_D(const DockWidget);
+
+        auto bar = d->bars[edge2index(edge)];
+        if (!bar)
+            return {};
+
+        const auto &buttons = bar->buttons(side);
+        QList<QWidget *> res;
+        res.reserve(buttons.size());
+        for (auto button : buttons) {
+            res.append(d->buttonData(button).widget);
+        }
+        return res;
+    }
+
+    void DockWidget::visitToolWindows(Qt::Edge edge, Side side, ToolWindowVisit visit,
+                                      void *visitor) const {
+        Q_D(const DockWidget);
+        auto bar = d->bars[edge2index(edge)];
+        if (!bar)
+            return;
+
+        // Indexed, a visitor changing the stripe cannot invalidate the walk
+        const auto &buttons = bar->buttons(side);
+        for (int i = 0; i < buttons.size(); ++i) {
+            auto button = buttons.at(i);
+            if (!visit(visitor, button, d->buttonData(button).widget))
+                break;
+        }
+    }
+
+    bool DockWidget::isMaterialized(const QAbstractButton *button) const {
+        Q_D(const DockWidget);
+        return d->buttonData(button).widget != nullptr;
+    }
+
+    bool DockWidget::addPerspective(const QString &name, const DockLayout &layout) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::addPerspective");
+
+        // At most one pinned tool window per stripe side can be visible
+        QSet<QString> ids;
+        for (int i = 0; i < 4; ++i) {
+            for (auto side : {Front, Back}) {
+                auto items = layout.items(index2edge(i), side);
+                int pinnedVisible = 0;
+                for (const auto &item : std::as_const(items)) {
+                    if (item.id.isEmpty() || ids.contains(item.id))
+                        return false;
+                    ids.insert(item.id);
+                    if (item.visible && item.viewMode == DockPinned)
+                        pinnedVisible++;
+                }
+                if (pinnedVisible > 1)
+                    return false;
+            }
+        }
+        for (auto orientation : {Qt::Horizontal, Qt::Vertical}) {
+            auto size = layout.orientationSizes(orientation).size();
+            if (size != 0 && size != 3)
+                return false;
+        }
+
+        if (!d->perspectives.contains(name)) {
+            d->perspectiveNames.append(name);
+        }
+        auto &perspective = d->perspectives[name];
+        perspective.layout = layout;
+        perspective.compiled = d->compileLayout(layout);
+        perspective.generation = d->registryGeneration;
+        return true;
+    }
+
+    void DockWidget::removePerspective(const QString &name) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::removePerspective");
+        if (!d->perspectives.remove(name))
+            return;
+        d->perspectiveNames.removeOne(name);
+        if (d->currentPerspective == name) {
+            d->currentPerspective.clear();
+        }
+    }
+
+    QStringList DockWidget::perspectives() const {
+        Q_D(const DockWidget);
+        return d->perspectiveNames;
+    }
+
+    QString DockWidget::currentPerspective() const {
+        Q_D(const DockWidget);
+        return d->currentPerspective;
+    }
+
+    bool DockWidget::setCurrentPerspective(const QString &name) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setCurrentPerspective");
+        auto it = d->perspectives.find(name);
+        if (it == d->perspectives.end())
+            return false;
+
+        // Tool windows were added or removed since the last compilation
+        auto &perspective = it.value();
+        if (perspective.generation != d->registryGeneration) {
+            perspective.compiled = d->compileLayout(perspective.layout);
+            perspective.generation = d->registryGeneration;
+        }
+
+        applyLayout(perspective.compiled);
+        d->currentPerspective = name;
+        return true;
+    }
+
+    QWidget *DockWidget::widget(const QAbstractButton *button) {
+        Q_D(const DockWidget);
+        return d->buttonData(button).widget;
+    }
+
+    ViewMode DockWidget::viewMode(const QAbstractButton *button) {
+        Q_D(const DockWidget);
+        return d->buttonData(button).viewMode;
+    }
+
+    void DockWidget::setViewMode(QAbstractButton *button, ViewMode viewMode) {
+        Q_D(DockWidget);
+        auto it = d->buttonDataHash.find(button);
+        if (it == d->buttonDataHash.end())
+            return;
+
+        auto &data = it.value();
+        auto oldViewMode = data.viewMode;
+        if (oldViewMode == viewMode) {
+            return;
+        }
+
+        // Not materialized, applied when the content gets created
+        if (!data.widget) {
+            data.viewMode = viewMode;
+            d->addChange(button, DockWidgetPrivate::ViewModeChanged);
+            emit viewModeChanged(button, viewMode);
+            return;
+        }
+
+        DockPerfTimer perf("DockWidget::setViewMode");
+        if (perf.isEnabled()) {
+            auto modes = QMetaEnum::fromType<ViewMode>();
+            perf.setDetail(QString("%1 %2 -> %3")
+                               .arg(data.id, modes.valueToKey(oldViewMode),
+                                    modes.valueToKey(viewMode)));
+        }
+
+        // Only the panel and the container of the tool window are touched, their layouts
+        // are activated once when the batch ends
+        DockBatchGuard guard(d, d->panels[edge2index(data.edge)]);
+        guard.add(data.container);
+
+        auto widget = data.widget;
+        auto container = data.container;
+        auto edgeIdx = edge2index(data.edge);
+        const auto oldGeometry =
+            static_cast<WidgetEventFilter *>(data.widgetEventFilter)->oldGeometry;
+        auto floatingHelper = static_cast<QMFloatingWindowHelper *>(data.floatingHelper);
+
+        // The content itself or the pooled host holding it
+        auto window = d->detachedWindow(data);
+        auto windowGeometry = [&](const QSize &size) {
+            if (!oldGeometry.isEmpty()) {
+                return QRect(oldGeometry.topLeft(), size.isEmpty() ? oldGeometry.size() : size);
+            }
+
+            QPoint offset;
+            switch (data.edge) {
+                case Qt::TopEdge:
+                    offset.ry() += button->height();
+                    break;
+                case Qt::BottomEdge:
+                    offset.ry() -= button->height() + size.height();
+                    break;
+                case Qt::LeftEdge:
+                    offset.rx() += button->width();
+                    break;
+                case Qt::RightEdge:
+                    offset.rx() -= button->width() + size.width();
+                    break;
+            }
+            return fitToScreen(QRect(button->mapToGlobal(QPoint()) + offset, size),
+                               button->screen()->geometry());
+        };
+        auto asWindow = [&](QWidget *target, const QRect &geometry) {
+            // Reparenting inherited the suspended updates of the batch, windows never get them back
+            if (!target->updatesEnabled()) {
+                target->setUpdatesEnabled(true);
+            }
+            target->setGeometry(geometry);
+            d->setWindowVisible(target, button->isChecked());
+        };
+        auto leaveHost = [&]() {
+            if (window != widget) {
+                window->hide();
+            }
+        };
+
+        auto layout = container->layout();
+        int restoredSize = 0;
+        switch (viewMode) {
+            case DockPinned: {
+                floatingHelper->setFloating(false);
+                widget->setWindowFlags(Qt::Widget);
+                layout->addWidget(widget);
+                widget->setVisible(true);
+                leaveHost();
+
+                // Restored together with the panel below
+                if (!oldGeometry.isEmpty()) {
+                    restoredSize =
+                        (edgeIdx % 2 == 1) ? oldGeometry.height() : oldGeometry.width();
+                }
+                break;
+            }
+
+            case Undocked: {
+                if (data.overlayExtent <= 0) {
+                    auto size = widget->size();
+                    bool vertical = data.edge == Qt::TopEdge || data.edge == Qt::BottomEdge;
+                    data.overlayExtent = vertical ? size.height() : size.width();
+                }
                 layout->removeWidget(widget);
-                widget->setParent(container);
-                floatingHelper->setFloating(true, Qt::Tool);
-                asWindow(size, extraOffset);
+                floatingHelper->setFloating(false);
+
+                // A plain child of the dock outside its layout, nothing else moves
+                widget->setParent(this, Qt::Widget);
+                leaveHost();
+                widget->setGeometry(d->overlayGeometry(data));
+                if (button->isChecked()) {
+                    widget->show();
+                    widget->raise();
+                }
                 break;
             }
 
+            case Floating:
             case Window: {
-                auto size = widget->size();
-                auto extraOffset = oldViewMode == DockPinned
-                                       ? QPoint()
-                                       : (widget->mapToGlobal(QPoint()) - widget->pos());
+                auto geometry = windowGeometry(widget->size());
                 layout->removeWidget(widget);
-                widget->setParent(nullptr);
-                floatingHelper->setFloating(false);
-                widget->setWindowFlags(Qt::Window);
-                asWindow(size, extraOffset);
+
+                if (data.windowPolicy == PooledWindow) {
+                    // Only the content moves, the host keeps its native window
+                    auto host = d->windowHost(button, viewMode);
+                    floatingHelper->setFloating(false);
+                    host->layout()->addWidget(widget);
+                    widget->show();
+                    if (window != host) {
+                        leaveHost();
+                    }
+                    asWindow(host, geometry);
+                    break;
+                }
+
+                if (viewMode == Floating) {
+                    widget->setParent(container);
+                    leaveHost();
+                    floatingHelper->setFloating(true, Qt::Tool);
+                } else {
+                    widget->setParent(nullptr);
+                    leaveHost();
+                    floatingHelper->setFloating(false);
+                    widget->setWindowFlags(Qt::Window);
+                }
+                asWindow(widget, geometry);
                 break;
             }
         }
@@ -743,30 +1989,66 @@ namespace JBDS {
         d->bars[edgeIdx]->buttonViewModeChanged(data.side, button);
 
         // Update panels
+        auto panel = d->panels[edgeIdx];
         if (button->isChecked()) {
-            auto panel = d->panels[edgeIdx];
             if (oldViewMode == DockPinned) {
                 panel->setContainerVisible(data.side, false);
             } else if (viewMode == DockPinned) {
                 panel->setContainerVisible(data.side, true);
                 panel->setCurrentWidget(data.side, data.container);
-
-                // We must refresh its layout
-                layout->invalidate();
             }
         }
+
+        if (restoredSize > 0) {
+            d->resizeEdge(edgeIdx, restoredSize);
+        }
+
+        d->addChange(button, DockWidgetPrivate::ViewModeChanged);
+        emit viewModeChanged(button, viewMode);
+    }
+
+    DockWidget::WindowPolicy DockWidget::windowPolicy(const QAbstractButton *button) const {
+        Q_D(const DockWidget);
+        return d->buttonData(button).windowPolicy;
+    }
+
+    void DockWidget::setWindowPolicy(QAbstractButton *button, WindowPolicy policy) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setWindowPolicy");
+        auto it = d->buttonDataHash.find(button);
+        if (it == d->buttonDataHash.end())
+            return;
+        it->windowPolicy = policy;
+    }
+
+    bool DockWidget::freezeWhileResizing(const QAbstractButton *button) const {
+        Q_D(const DockWidget);
+        return d->buttonData(button).freezeWhileResizing;
+    }
+
+    void DockWidget::setFreezeWhileResizing(QAbstractButton *button, bool on) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setFreezeWhileResizing");
+        auto it = d->buttonDataHash.find(button);
+        if (it == d->buttonDataHash.end())
+            return;
+        it->freezeWhileResizing = on;
     }
 
     int DockWidget::edgeSize(Qt::Edge edge) const {
         Q_D(const DockWidget);
+        auto panel = d->panels[edge2index(edge)];
+        if (!panel)
+            return 0;
+
         switch (edge) {
             case Qt::TopEdge:
             case Qt::BottomEdge: {
-                return d->panels[edge2index(edge)]->height();
+                return panel->height();
             }
             case Qt::LeftEdge:
             case Qt::RightEdge: {
-                return d->panels[edge2index(edge)]->width();
+                return panel->width();
             }
         }
         return 0;
@@ -774,137 +2056,181 @@ namespace JBDS {
 
     void DockWidget::setEdgeSize(Qt::Edge edge, int size) {
         Q_D(DockWidget);
-
-        switch (edge) {
-            case Qt::TopEdge: {
-                auto sizes = d->verticalSplitter->sizes();
-                auto offset = size - sizes[0];
-                sizes[0] += offset;
-                sizes[1] -= offset;
-                d->verticalSplitter->setSizes(sizes);
-                break;
-            }
-            case Qt::BottomEdge: {
-                auto sizes = d->verticalSplitter->sizes();
-                auto offset = size - sizes[2];
-                d->orgVSizes = sizes;
-                sizes[2] += offset;
-                sizes[1] -= offset;
-                d->verticalSplitter->setSizes(sizes);
-                break;
-            }
-            case Qt::LeftEdge: {
-                auto sizes = d->horizontalSplitter->sizes();
-                auto offset = size - sizes[0];
-                sizes[0] += offset;
-                sizes[1] -= offset;
-                d->horizontalSplitter->setSizes(sizes);
-                break;
-            }
-            case Qt::RightEdge: {
-                auto sizes = d->horizontalSplitter->sizes();
-                auto offset = size - sizes[2];
-                sizes[2] += offset;
-                sizes[1] -= offset;
-                d->horizontalSplitter->setSizes(sizes);
-                break;
-            }
-        }
+        JBDS_TRACE_SCOPE("DockWidget::setEdgeSize");
+        d->finishTransition();
+        d->resizeEdge(edge2index(edge), size);
     }
 
     QList<int> DockWidget::orientationSizes(Qt::Orientation orientation) const {
+        int sizes[3];
+        orientationSizes(orientation, sizes);
+        return {sizes[0], sizes[1], sizes[2]};
+    }
+
+    void DockWidget::orientationSizes(Qt::Orientation orientation, int (&sizes)[3]) const {
         Q_D(const DockWidget);
-        switch (orientation) {
-            case Qt::Horizontal: {
-                auto sizes = d->horizontalSplitter->sizes();
-                if (sizes == QList<int>{0, 0, 0}) {
-                    sizes = {0, d->horizontalSplitter->width(), 0};
-                }
-                return sizes;
-            }
-            case Qt::Vertical: {
-                auto sizes = d->verticalSplitter->sizes();
-                if (sizes == QList<int>{0, 0, 0}) {
-                    sizes = {0, d->verticalSplitter->height(), 0};
-                }
-                return sizes;
-            }
+        d->splitterSizes(orientation, sizes);
+        if (sizes[0] == 0 && sizes[1] == 0 && sizes[2] == 0) {
+            sizes[1] = (orientation == Qt::Horizontal) ? d->horizontalSplitter->width()
+                                                       : d->verticalSplitter->height();
         }
-        return {};
     }
 
     void DockWidget::setOrientationSizes(Qt::Orientation orientation, const QList<int> &sizes) {
         Q_D(DockWidget);
-        switch (orientation) {
-            case Qt::Horizontal:
-                d->horizontalSplitter->setSizes(sizes);
-                break;
-            case Qt::Vertical:
-                d->verticalSplitter->setSizes(sizes);
-                break;
-        }
+        JBDS_TRACE_SCOPE("DockWidget::setOrientationSizes");
+        d->finishTransition();
+        d->setSplitterSizes(orientation, sizes);
     }
 
     void DockWidget::toggleMaximize(Qt::Edge edge) {
         Q_D(DockWidget);
-        switch (edge) {
-            case Qt::TopEdge: {
-                auto offset = d->horizontalSplitter->height() -
-                              d->horizontalSplitter->minimumSizeHint().height();
-                if (offset == 0) {
-                    d->verticalSplitter->setSizes(d->orgVSizes);
-                } else {
-                    auto sizes = d->verticalSplitter->sizes();
-                    d->orgVSizes = sizes;
-                    sizes[0] += offset;
-                    sizes[1] -= offset;
-                    d->verticalSplitter->setSizes(sizes);
-                }
-                break;
-            }
-            case Qt::BottomEdge: {
-                auto offset = d->horizontalSplitter->height() -
-                              d->horizontalSplitter->minimumSizeHint().height();
-                if (offset == 0) {
-                    d->verticalSplitter->setSizes(d->orgVSizes);
-                } else {
-                    auto sizes = d->verticalSplitter->sizes();
-                    d->orgVSizes = sizes;
-                    sizes[2] += offset;
-                    sizes[1] -= offset;
-                    d->verticalSplitter->setSizes(sizes);
+        JBDS_TRACE_SCOPE("DockWidget::toggleMaximize");
+
+        int edgeIdx = edge2index(edge);
+        bool vertical = edgeIdx % 2 == 1;
+        auto orientation = vertical ? Qt::Vertical : Qt::Horizontal;
+        auto &orgSizes = vertical ? d->orgVSizes : d->orgHSizes;
+        d->finishTransition();
+
+        // Let the panel take everything but the minimum of the central area
+        auto input = d->layoutInput();
+        input.panels[edgeIdx].size = DockLayoutEngine::Unbounded;
+        input.priority = edgeIdx;
+        auto res = d->computeLayout(input);
+
+        int middle = vertical ? d->horizontalSplitter->height() : d->centralContainer->width();
+        int maximizedMiddle = vertical ? res.verticalSizes[1] : res.horizontalSizes[1];
+        auto target = orgSizes;
+        if (middle != maximizedMiddle) {
+            orgSizes = d->splitterSizes(orientation);
+            const auto &sizes = vertical ? res.verticalSizes : res.horizontalSizes;
+            target = {sizes[0], sizes[1], sizes[2]};
+        }
+
+        if (d->canAnimate() && target.size() == 3) {
+            d->startTransition(orientation, d->splitterSizes(orientation), target);
+        } else {
+            d->setSplitterSizes(orientation, target);
+        }
+    }
+
+    int DockWidget::animationDuration() const {
+        Q_D(const DockWidget);
+        return d->animationDuration;
+    }
+
+    void DockWidget::setAnimationDuration(int msecs) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setAnimationDuration");
+        d->animationDuration = qMax(0, msecs);
+    }
+
+    int DockWidget::opaqueResizeBudget() const {
+        Q_D(const DockWidget);
+        return d->resizeTuning.budget;
+    }
+
+    int DockWidget::opaqueRecoveryBudget() const {
+        Q_D(const DockWidget);
+        return d->resizeTuning.recoveryBudget;
+    }
+
+    void DockWidget::setOpaqueResizeBudgets(int budget, int recoveryBudget) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setOpaqueResizeBudgets");
+        d->resizeTuning.budget = qMax(0, budget);
+        d->resizeTuning.recoveryBudget = qBound(0, recoveryBudget, d->resizeTuning.budget);
+    }
+
+    int DockWidget::opaqueResizeFallbacks() const {
+        Q_D(const DockWidget);
+        return d->resizeTuning.fallbacks;
+    }
+
+    int DockWidget::opaqueResizeRecoveries() const {
+        Q_D(const DockWidget);
+        return d->resizeTuning.recoveries;
+    }
+
+    quint64 DockWidget::counter(Counter counter) const {
+        Q_D(const DockWidget);
+        return d->counters.values[counter].load(std::memory_order_relaxed);
+    }
+
+    void DockWidget::resetCounters() {
+        Q_D(DockWidget);
+        for (auto &value : d->counters.values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    DockLayout DockWidget::currentLayout() const {
+        Q_D(const DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::currentLayout");
+
+        DockLayout layout;
+        for (auto bar : d->bars) {
+            if (!bar)
+                continue;
+            for (auto side : {Front, Back}) {
+                const auto &buttons = bar->buttons(side);
+                QList<DockLayout::Item> items;
+                items.reserve(buttons.size());
+                for (auto button : buttons) {
+                    const auto &data = d->buttonData(button);
+                    items.append({data.id, data.viewMode, button->isChecked()});
                 }
-                break;
+                layout.setItems(bar->edge(), side, items);
             }
-            case Qt::LeftEdge: {
-                auto offset =
-                    d->centralContainer->width() - d->centralContainer->minimumSizeHint().width();
-                if (offset == 0) {
-                    d->horizontalSplitter->setSizes(d->orgHSizes);
-                } else {
-                    auto sizes = d->horizontalSplitter->sizes();
-                    d->orgHSizes = sizes;
-                    sizes[0] += offset;
-                    sizes[1] -= offset;
-                    d->horizontalSplitter->setSizes(sizes);
-                }
-                break;
+        }
+        layout.setOrientationSizes(Qt::Horizontal, orientationSizes(Qt::Horizontal));
+        layout.setOrientationSizes(Qt::Vertical, orientationSizes(Qt::Vertical));
+
+        // Tool windows without an id could not be found again
+        QStringList recentIds;
+        for (auto button = d->recentHead; button; button = d->buttonData(button).recentNext) {
+            const auto &id = d->buttonData(button).id;
+            if (!id.isEmpty())
+                recentIds.append(id);
+        }
+        layout.setRecentIds(recentIds);
+        return layout;
+    }
+
+    int DockWidget::applyLayout(const DockLayout &layout) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::applyLayout");
+
+        d->finishTransition();
+
+        auto ops = diffLayouts(currentLayout(), layout);
+        if (ops.isEmpty()) {
+            d->restoreRecent(layout.recentIds());
+            return 0;
+        }
+
+        const auto &buttons = d->buttonsById();
+
+        // The panels the tool windows leave and join
+        DockBatchGuard guard(d);
+        for (const auto &op : std::as_const(ops)) {
+            if (op.type == DockLayoutOperation::SetSizes)
+                continue;
+            if (auto button = buttons.value(op.id)) {
+                guard.add(d->panels[edge2index(d->buttonData(button).edge)]);
             }
-            case Qt::RightEdge: {
-                auto offset =
-                    d->centralContainer->width() - d->centralContainer->minimumSizeHint().width();
-                if (offset == 0) {
-                    d->horizontalSplitter->setSizes(d->orgHSizes);
-                } else {
-                    auto sizes = d->horizontalSplitter->sizes();
-                    d->orgHSizes = sizes;
-                    sizes[2] += offset;
-                    sizes[1] -= offset;
-                    d->horizontalSplitter->setSizes(sizes);
-                }
-                break;
+            if (op.type == DockLayoutOperation::Move) {
+                guard.add(d->panels[edge2index(op.edge)]);
             }
         }
+        for (const auto &op : std::as_const(ops)) {
+            d->applyLayoutOperation(op, buttons);
+        }
+
+        // After the tool windows shown above took the head
+        d->restoreRecent(layout.recentIds());
+        return int(ops.size());
     }
 
     QWidget *DockWidget::findButton(const QWidget *w) const {
@@ -912,14 +2238,81 @@ namespace JBDS {
         return d->widgetIndexes.value(const_cast<QWidget *>(w));
     }
 
+    void DockWidget::activateToolWindow(QAbstractButton *button) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::activateToolWindow");
+        if (!d->buttonDataHash.contains(button))
+            return;
+
+        // Through the button, what a click would do follows
+        if (!button->isChecked()) {
+            button->setChecked(true);
+        }
+
+        auto w = d->buttonData(button).widget;
+        if (!w)
+            return;
+        if (auto window = w->window(); window != this->window()) {
+            window->raise();
+            window->activateWindow();
+        }
+        w->setFocus(Qt::OtherFocusReason);
+    }
+
+    QList<QAbstractButton *> DockWidget::findToolWindows(const QString &pattern, int max) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::findToolWindows");
+        d->updateAppearances();
+        const auto &res = d->searchIndex()->match(pattern, max);
+        return QList<QAbstractButton *>(res.begin(), res.end());
+    }
+
+    void DockWidget::showQuickSwitcher() {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::showQuickSwitcher");
+        if (!d->quickSwitcher) {
+            d->quickSwitcher = new DockQuickSwitcher(d, this);
+        }
+        d->quickSwitcher->popup();
+    }
+
+    QList<QAbstractButton *> DockWidget::recentToolWindows(int max) const {
+        Q_D(const DockWidget);
+        QList<QAbstractButton *> res;
+        for (auto button = d->recentHead; button && res.size() != max;
+             button = d->buttonData(button).recentNext) {
+            res.append(button);
+        }
+        return res;
+    }
+
+    void DockWidget::showRecentSwitcher(bool backward) {
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::showRecentSwitcher");
+        if (!d->recentSwitcher) {
+            d->recentSwitcher = new DockRecentSwitcher(d, this);
+        }
+        d->recentSwitcher->popup(backward);
+    }
+
     bool DockWidget::barVisible(Qt::Edge edge) {
         Q_D(const DockWidget);
-        return d->bars[edge2index(edge)]->isVisible();
+        auto edgeIdx = edge2index(edge);
+        if (auto bar = d->bars[edgeIdx])
+            return bar->isVisible();
+        return !d->barHidden[edgeIdx] && isVisible();
     }
 
     void DockWidget::setBarVisible(Qt::Edge edge, bool visible) {
-        Q_D(const DockWidget);
-        d->bars[edge2index(edge)]->setVisible(visible);
+        Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setBarVisible");
+        auto edgeIdx = edge2index(edge);
+        d->barHidden[edgeIdx] = !visible;
+        if (visible) {
+            d->sideBar(edgeIdx)->setVisible(true);
+        } else if (auto bar = d->bars[edgeIdx]) {
+            bar->setVisible(false);
+        }
     }
 
     bool DockWidget::dockAttribute(DockWidget::Attribute attr) {
@@ -929,7 +2322,19 @@ namespace JBDS {
 
     void DockWidget::setDockAttribute(DockWidget::Attribute attr, bool on) {
         Q_D(DockWidget);
+        JBDS_TRACE_SCOPE("DockWidget::setDockAttribute");
         d->attributes[attr] = on;
+        if (attr == AdaptiveOpaqueResize) {
+            d->resizeTuning.adaptive = on;
+        } else if (attr == PerformanceOverlay) {
+            if (on && !d->hud) {
+                d->hud = new DockHud(d, this);
+            }
+            if (d->hud) {
+                d->hud->setVisible(on);
+                d->updateHud();
+            }
+        }
     }
 
     DockWidget::DockWidget(DockWidgetPrivate &d, DockButtonDelegate *delegate, QWidget *parent)
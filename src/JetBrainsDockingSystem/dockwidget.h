@@ -4,9 +4,14 @@
 #ifndef DOCKWIDGET_H
 #define DOCKWIDGET_H
 
+#include <functional>
+#include <memory>
+#include <type_traits>
+
 #include <QtWidgets/QFrame>
 
 #include <JetBrainsDockingSystem/dockbuttondelegate.h>
+#include <JetBrainsDockingSystem/docklayout.h>
 
 namespace JBDS {
 
@@ -16,6 +21,10 @@ namespace JBDS {
         Q_OBJECT
         Q_DECLARE_PRIVATE(DockWidget)
         Q_PROPERTY(int resizeMargin READ resizeMargin WRITE setResizeMargin)
+        Q_PROPERTY(int barPadding READ barPadding WRITE setBarPadding)
+        Q_PROPERTY(int buttonSpacing READ buttonSpacing WRITE setButtonSpacing)
+        Q_PROPERTY(QColor highlightColor READ highlightColor WRITE setHighlightColor)
+        Q_PROPERTY(QColor handleColor READ handleColor WRITE setHandleColor)
     public:
         explicit DockWidget(QWidget *parent = nullptr);
         DockWidget(DockButtonDelegate *delegate, QWidget *parent = nullptr);
@@ -24,51 +33,239 @@ namespace JBDS {
         enum Attribute {
             ViewModeContextMenu,
             AutoFloatDraggingOutside,
+            FreezeCentralWhileResizing,
+            AdaptiveOpaqueResize,
+            AnimatePanels,
+            PerformanceOverlay,
+        };
+
+        // How the native window of a Floating or Window tool window is managed
+        enum WindowPolicy {
+            RecreateWindow,      // The content becomes the window, recreated on each switch
+            PooledWindow,        // The content is moved into hosts kept for the lifetime
+            DestroyWindowOnHide, // Like RecreateWindow, released when the window is hidden
+        };
+
+        using WidgetFactory = std::function<QWidget *()>;
+
+        // Estimates in bytes, the allocations made by the objects themselves are left out
+        struct MemoryUsage {
+            int objects = 0; // Content subtree
+            int widgets = 0;
+            qint64 contentBytes = 0;
+            qint64 windowBytes = 0;  // Backing stores of detached windows
+            qint64 pixmapBytes = 0;  // Snapshots covering the content
+            qint64 libraryBytes = 0; // Button, container, hosts, helpers, filters, records
+            int orphans = 0; // Dock total only, containers and hosts no tool window owns
+
+            inline qint64 totalBytes() const {
+                return contentBytes + windowBytes + pixmapBytes + libraryBytes;
+            }
+        };
+
+        // Cumulative counts of the work done by the dock, cheap enough to stay on
+        enum Counter {
+            Relayouts,             // Runs of the layout engine
+            SplitterResizes,       // Sizes set on the splitters
+            BarHighlightRelayouts, // Bar geometry updates while showing a drop target
+            DragMoves,
+            DragMovesCoalesced, // Moves that left the drop target as it was
+            DockFilterEvents,   // Events seen by each kind of event filter
+            WidgetFilterEvents,
+            ButtonFilterEvents,
+            DragFilterEvents,
+            SnapshotFilterEvents,
+            FloatingFilterEvents,
+            NativeWindowsCreated, // By detached tool windows
+            NativeWindowsReleased,
+            ToolWindowsMaterialized,
+            CounterCount,
+        };
+
+        // Everything that changed since the previous layoutChanged(), a tool window appears
+        // at most once per list. Removed buttons may already be deleted, compare only.
+        struct ChangeSet {
+            QList<QAbstractButton *> added;
+            QList<QAbstractButton *> removed;
+            QList<QAbstractButton *> moved;
+            QList<QAbstractButton *> viewModeChanged;
+            QList<QAbstractButton *> visibilityChanged;
+            QList<QAbstractButton *> appearanceChanged;
+            QList<Qt::Edge> edgeSizeChanged;
+
+            inline bool isEmpty() const {
+                return added.isEmpty() && removed.isEmpty() && moved.isEmpty() &&
+                       viewModeChanged.isEmpty() && visibilityChanged.isEmpty() &&
+                       appearanceChanged.isEmpty() && edgeSizeChanged.isEmpty();
+            }
         };
 
     public:
         int resizeMargin() const;
         void setResizeMargin(int resizeMargin);
 
+        // Look of the bars and splitters without a style sheet, invalid colors fall back
+        // to the palette
+        int barPadding() const;
+        void setBarPadding(int padding);
+        int buttonSpacing() const;
+        void setButtonSpacing(int spacing);
+        QColor highlightColor() const;
+        void setHighlightColor(const QColor &color);
+        QColor handleColor() const;
+        void setHandleColor(const QColor &color);
+
         QWidget *widget() const;
         void setWidget(QWidget *w);
         QWidget *takeWidget();
 
         inline QAbstractButton *addWidget(Qt::Edge edge, Side side, QWidget *w);
         QAbstractButton *insertWidget(Qt::Edge edge, Side side, int index, QWidget *w);
+
+        // The content is created by the factory when the tool window is shown the first time
+        inline QAbstractButton *addWidget(Qt::Edge edge, Side side, const QString &id,
+                                          const WidgetFactory &factory);
+        QAbstractButton *insertWidget(Qt::Edge edge, Side side, int index, const QString &id,
+                                      const WidgetFactory &factory);
+        bool isMaterialized(const QAbstractButton *button) const;
+
         void removeWidget(QAbstractButton *button);
         void moveWidget(QAbstractButton *button, Qt::Edge edge, Side side, int index = -1);
         int widgetCount(Qt::Edge edge, Side side) const;
-        QList<QWidget *> widgets(Qt::Edge edge, Side side) const;
+        QList<QWidget *> widgets(Qt::Edge edge, Side side) const; // nullptr if not materialized
+
+        // Visits a stripe in order without building a list, the content is nullptr if not
+        // materialized. A visitor returning bool stops the walk by returning false.
+        template <class Visitor>
+        void forEachToolWindow(Qt::Edge edge, Side side, Visitor &&visitor) const;
 
         QWidget *widget(const QAbstractButton *button);
         ViewMode viewMode(const QAbstractButton *button);
         void setViewMode(QAbstractButton *button, ViewMode viewMode);
 
+        // Shows a snapshot instead of the content while a splitter handle is dragged
+        bool freezeWhileResizing(const QAbstractButton *button) const;
+        void setFreezeWhileResizing(QAbstractButton *button, bool on);
+
+        // Takes effect on the next view mode change
+        WindowPolicy windowPolicy(const QAbstractButton *button) const;
+        void setWindowPolicy(QAbstractButton *button, WindowPolicy policy);
+
         int edgeSize(Qt::Edge edge) const;
         void setEdgeSize(Qt::Edge edge, int size);
         QList<int> orientationSizes(Qt::Orientation orientation) const;
+        void orientationSizes(Qt::Orientation orientation, int (&sizes)[3]) const;
         void setOrientationSizes(Qt::Orientation orientation, const QList<int> &sizes);
         void toggleMaximize(Qt::Edge edge);
 
+        // Length of the AnimatePanels transitions in milliseconds
+        int animationDuration() const;
+        void setAnimationDuration(int msecs);
+
+        // Frame time budgets of AdaptiveOpaqueResize, in microseconds
+        int opaqueResizeBudget() const;
+        int opaqueRecoveryBudget() const;
+        void setOpaqueResizeBudgets(int budget, int recoveryBudget);
+        int opaqueResizeFallbacks() const;
+        int opaqueResizeRecoveries() const;
+
+        // May be read from any thread while the dock is alive
+        quint64 counter(Counter counter) const;
+        void resetCounters();
+
+        DockLayout currentLayout() const;
+        int applyLayout(const DockLayout &layout);
+
+        bool addPerspective(const QString &name, const DockLayout &layout);
+        void removePerspective(const QString &name);
+        QStringList perspectives() const;
+        QString currentPerspective() const;
+        bool setCurrentPerspective(const QString &name);
+
         QWidget *findButton(const QWidget *w) const;
 
+        // Shows the tool window like its button does and gives its content the focus
+        void activateToolWindow(QAbstractButton *button);
+
+        // Tool windows whose title or id contains the pattern as a subsequence, best first
+        QList<QAbstractButton *> findToolWindows(const QString &pattern, int max = -1);
+
+        // Popup searching as the user types, the chosen tool window is activated
+        void showQuickSwitcher();
+
+        // Most recently activated first, by a check of the button or the focus entering the
+        // content. Tool windows never activated are left out.
+        QList<QAbstractButton *> recentToolWindows(int max = -1) const;
+
+        // Popup walking the above like Ctrl+Tab does, Tab and Shift+Tab move while Ctrl is
+        // held and releasing it activates the selection
+        void showRecentSwitcher(bool backward = false);
+
+        MemoryUsage memoryUsage(const QAbstractButton *button) const;
+        MemoryUsage memoryUsage() const;
+
         bool barVisible(Qt::Edge edge);
         void setBarVisible(Qt::Edge edge, bool visible);
 
         bool dockAttribute(Attribute attr);
         void setDockAttribute(Attribute attr, bool on = true);
 
+    Q_SIGNALS:
+        // Emitted as each change happens
+        void toolWindowAdded(QAbstractButton *button);
+        void toolWindowRemoved(QAbstractButton *button);
+        void toolWindowMoved(QAbstractButton *button, Qt::Edge edge, JBDS::Side side, int index);
+        void viewModeChanged(QAbstractButton *button, JBDS::ViewMode viewMode);
+        void visibilityChanged(QAbstractButton *button, bool visible);
+
+        // Text or icon of the button, noticed when the button is painted next. Those set
+        // before its first paint are not reported. Buttons on a hidden or not yet created
+        // bar are only looked at when a switcher opens or findToolWindows() runs.
+        void appearanceChanged(QAbstractButton *button);
+        void edgeSizeChanged(Qt::Edge edge, int size);
+
+        // The changes above batched once per event loop iteration
+        void layoutChanged(const JBDS::DockWidget::ChangeSet &changes);
+
     protected:
         DockWidget(DockWidgetPrivate &d, DockButtonDelegate *delegate, QWidget *parent = nullptr);
 
         QScopedPointer<DockWidgetPrivate> d_ptr;
+
+    private:
+        using ToolWindowVisit = bool (*)(void *visitor, QAbstractButton *button, QWidget *w);
+        void visitToolWindows(Qt::Edge edge, Side side, ToolWindowVisit visit,
+                              void *visitor) const;
     };
 
     inline QAbstractButton *DockWidget::addWidget(Qt::Edge edge, Side side, QWidget *w) {
         return insertWidget(edge, side, -1, w);
     }
 
+    inline QAbstractButton *DockWidget::addWidget(Qt::Edge edge, Side side, const QString &id,
+                                                  const WidgetFactory &factory) {
+        return insertWidget(edge, side, -1, id, factory);
+    }
+
+    template <class Visitor>
+    inline void DockWidget::forEachToolWindow(Qt::Edge edge, Side side,
+                                              Visitor &&visitor) const {
+        using Type = std::remove_reference_t<Visitor>;
+        auto visit = [](void *v, QAbstractButton *button, QWidget *w) -> bool {
+            auto &f = *static_cast<Type *>(v);
+            if constexpr (std::is_void_v<decltype(f(button, w))>) {
+                f(button, w);
+                return true;
+            } else {
+                return f(button, w);
+            }
+        };
+        visitToolWindows(edge, side, visit,
+                         const_cast<void *>(static_cast<const void *>(std::addressof(visitor))));
+    }
+
 }
 
+Q_DECLARE_METATYPE(JBDS::DockWidget::ChangeSet)
+
 #endif // DOCKWIDGET_H
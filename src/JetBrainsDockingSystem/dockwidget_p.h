@@ -13,27 +13,62 @@
 // version without notice, or may even be removed.
 //
 
+#include <atomic>
+
 #include <QtCore/QSet>
 #include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QVariantAnimation>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QStackedWidget>
 
 #include <JetBrainsDockingSystem/dockwidget.h>
+#include <JetBrainsDockingSystem/docklayout_p.h>
+#include <JetBrainsDockingSystem/docklayoutengine_p.h>
 #include <JetBrainsDockingSystem/dockpanel_p.h>
+#include <JetBrainsDockingSystem/docksplitter_p.h>
 #include <JetBrainsDockingSystem/docksidebar_p.h>
 #include <JetBrainsDockingSystem/dockdragcontroller_p.h>
+#include <JetBrainsDockingSystem/dockhud_p.h>
+#include <JetBrainsDockingSystem/dockquickswitcher_p.h>
+#include <JetBrainsDockingSystem/dockrecentswitcher_p.h>
+#include <JetBrainsDockingSystem/docksearchindex_p.h>
 
 namespace JBDS {
 
+    class DockProfilerPrivate;
+
     struct DockButtonData {
         ViewMode viewMode = DockPinned;
         Qt::Edge edge = Qt::TopEdge;
         Side side = Front;
+        QString id;
+        QString title;       // Text and icon of the button when last looked at
+        qint64 iconKey = 0;
+        bool appearanceSeen = false; // Set up by the caller until then, not a change
         QWidget *widget = nullptr;
         QWidget *container = nullptr;
+        DockWidget::WidgetFactory factory;
+        bool freezeWhileResizing = false;
+        int overlayExtent = 0; // Undocked width or height, 0 for default
+        DockWidget::WindowPolicy windowPolicy = DockWidget::RecreateWindow;
+        QWidget *hosts[2] = {}; // Pooled Floating and Window hosts
         QObject *floatingHelper = nullptr;
         QObject *widgetEventFilter = nullptr;
         QObject *buttonEventFilter = nullptr;
+
+        // Neighbours in the activation history, see `DockWidgetPrivate::recentHead`
+        QAbstractButton *recentPrev = nullptr;
+        QAbstractButton *recentNext = nullptr;
+    };
+
+    // Written by the GUI thread, read by any
+    struct DockCounters {
+        std::atomic<quint64> values[DockWidget::CounterCount] = {};
+
+        inline void add(DockWidget::Counter counter) {
+            values[counter].fetch_add(1, std::memory_order_relaxed);
+        }
     };
 
     class DockWidgetPrivate : public QObject {
@@ -50,10 +85,18 @@ namespace JBDS {
 
         int resizeMargin = 8;
 
-        // Modules
-        DockPanel *panels[4];
-        DockSideBar *bars[4];
-        QSplitter *horizontalSplitter, *verticalSplitter;
+        int barPadding = 0;
+        int buttonSpacing = -1; // Style default
+        QColor highlightColor;
+        QColor handleColor;
+        QList<DockSplitter *> splitters() const;
+
+        // Modules, panels and bars are null until first used
+        DockPanel *panels[4] = {};
+        DockSideBar *bars[4] = {};
+        QSpacerItem *barPlaceholders[4] = {};
+        bool barHidden[4] = {};
+        DockSplitter *horizontalSplitter, *verticalSplitter;
         QStackedWidget *centralContainer;
         QGridLayout *mainLayout;
 
@@ -61,11 +104,84 @@ namespace JBDS {
 
         QHash<QAbstractButton *, DockButtonData> buttonDataHash;
         QHash<QWidget *, QAbstractButton *> widgetIndexes;
+        QList<QPointer<QWidget>> retiredWidgets; // Containers and hosts of removed tool windows
 
         QList<int> orgHSizes;
         QList<int> orgVSizes;
 
-        bool attributes[2] = {false};
+        DockCounters counters;
+        DockProfilerPrivate *profiler = nullptr; // Fed by the tool window filters while running
+
+        DockLayoutEngine::Input layoutInput() const;
+        DockLayoutEngine::Result computeLayout(const DockLayoutEngine::Input &input);
+        void applySplitterSizes(Qt::Orientation orientation, const DockLayoutEngine::Result &res);
+        void resizeEdge(int index, int size);
+
+        bool attributes[6] = {false};
+
+        DockResizeTuning resizeTuning;
+        QList<QPointer<DockContentSnapshot>> snapshots;
+        void connectSplitter(DockSplitter *splitter);
+        void freezeContents();
+        void thawContents();
+
+        // Splitter sizes animated toward a target, contents are snapshots until the end
+        struct Transition {
+            Qt::Orientation orientation = Qt::Horizontal;
+            QList<int> from;
+            QList<int> to;
+            QList<QPair<QPointer<QWidget>, QSize>> minimums;
+            QList<QPointer<DockContentSnapshot>> snapshots;
+            std::function<void()> finish;
+        };
+        int animationDuration = 150;
+        QVariantAnimation *transitionAnimation = nullptr;
+        Transition transition;
+        bool canAnimate() const;
+        void startTransition(Qt::Orientation orientation, const QList<int> &from,
+                             const QList<int> &to, const std::function<void()> &finish = {});
+        void finishTransition();
+
+        struct BatchScope {
+            QPointer<QWidget> widget;
+            bool updatesEnabled;
+            QList<QPointer<QLayout>> layouts; // Disabled by the batch, innermost first
+        };
+        int batchDepth = 0;
+        QList<BatchScope> batchScopes;
+        void beginBatch();
+        void addToBatch(QWidget *scope);
+        void endBatch();
+
+        int registryGeneration = 0;
+        mutable QHash<QString, QAbstractButton *> idCache;
+        mutable int idCacheGeneration = -1;
+        const QHash<QString, QAbstractButton *> &buttonsById() const;
+
+        struct Perspective {
+            DockLayout layout;
+            DockLayout compiled;
+            int generation = -1;
+        };
+        QHash<QString, Perspective> perspectives;
+        QStringList perspectiveNames;
+        QString currentPerspective;
+        DockLayout compileLayout(const DockLayout &layout) const;
+
+        QAbstractButton *createButton(Qt::Edge edge, Side side, const QString &id);
+        void attachWidget(QAbstractButton *button, QWidget *w);
+        bool materialize(QAbstractButton *button);
+
+        void applyLayoutOperation(const DockLayoutOperation &op,
+                                  const QHash<QString, QAbstractButton *> &buttons);
+
+        DockSideBar *sideBar(int index);
+        DockPanel *panel(int index);
+
+        // Always three sizes, zero for panels not created yet
+        QList<int> splitterSizes(Qt::Orientation orientation) const;
+        void splitterSizes(Qt::Orientation orientation, int (&sizes)[3]) const;
+        void setSplitterSizes(Qt::Orientation orientation, QList<int> sizes);
 
         void barButtonAdded(Qt::Edge edge, Side side, QAbstractButton *button);
         void barButtonRemoved(Qt::Edge edge, Side side, QAbstractButton *button);
@@ -78,20 +194,115 @@ namespace JBDS {
             return q->d_func();
         }
 
-        inline bool dockVisible(const QAbstractButton *button) {
-            return button->isChecked() &&
-                   buttonDataHash.value(const_cast<QAbstractButton *>(button)).viewMode ==
-                       DockPinned;
+        // Empty record for unknown buttons, nothing is copied
+        inline const DockButtonData &buttonData(const QAbstractButton *button) const {
+            static const DockButtonData empty;
+            auto it = buttonDataHash.constFind(const_cast<QAbstractButton *>(button));
+            return (it == buttonDataHash.constEnd()) ? empty : it.value();
+        }
+
+        inline bool dockVisible(const QAbstractButton *button) const {
+            return button->isChecked() && buttonData(button).viewMode == DockPinned;
         }
 
         static void moveWidgetToPos(QWidget *w, const QPoint &pos);
 
+        QWidget *windowHost(QAbstractButton *button, ViewMode viewMode);
+        static QWidget *detachedWindow(const DockButtonData &data);
+        void setWindowVisible(QWidget *window, bool visible);
+        void releaseNativeWindow(QWidget *w);
+
+        QRect overlayGeometry(const DockButtonData &data) const;
+        void updateOverlays();
+
+        DockHud *hud = nullptr;
+        void updateHud();
+
+        // Reported by layoutChanged() on the next event loop iteration
+        enum Change {
+            ToolWindowAdded = 0x1,
+            ToolWindowRemoved = 0x2,
+            ToolWindowMoved = 0x4,
+            ViewModeChanged = 0x8,
+            VisibilityChanged = 0x10,
+            AppearanceChanged = 0x20,
+        };
+        DockWidget::ChangeSet pendingChanges;
+        QHash<QAbstractButton *, int> pendingKinds;
+        int reportedEdgeSizes[4] = {};
+        bool changesPosted = false;
+        void addChange(QAbstractButton *button, Change change);
+        bool appearanceOutdated(const QAbstractButton *button) const;
+        void updateAppearance(QAbstractButton *button);
+        void updateAppearances();
+        void edgeResized(int index);
+        void postChanges();
+        void flushChanges();
+
+        // Built by the first search, kept up to date from then on
+        QScopedPointer<DockSearchIndex> search;
+        DockSearchIndex *searchIndex();
+        DockQuickSwitcher *quickSwitcher = nullptr;
+
+        // Activation history linked through the records, most recent first, each update
+        // takes constant time
+        QAbstractButton *recentHead = nullptr;
+        void touchRecent(QAbstractButton *button);
+        void unlinkRecent(QAbstractButton *button, DockButtonData &data);
+        void restoreRecent(const QStringList &ids);
+        DockRecentSwitcher *recentSwitcher = nullptr;
+
+    protected:
+        bool eventFilter(QObject *obj, QEvent *event) override;
+
     private:
         void _q_widgetDestroyed();
         void _q_buttonDestroyed();
         void _q_buttonToggled(bool checked);
+        void _q_buttonVisibilityChanged(bool checked);
+        void _q_focusChanged(QWidget *old, QWidget *now);
     };
 
+    // Suppresses repaints of the given parts of the dock and the activation of their layouts,
+    // the layouts are activated once when the outermost batch ends
+    class DockBatchGuard {
+    public:
+        explicit DockBatchGuard(DockWidgetPrivate *d, QWidget *scope = nullptr) : d(d) {
+            d->beginBatch();
+            d->addToBatch(scope);
+        }
+        ~DockBatchGuard() {
+            d->endBatch();
+        }
+
+        void add(QWidget *scope) {
+            d->addToBatch(scope);
+        }
+
+    private:
+        DockWidgetPrivate *d;
+
+        Q_DISABLE_COPY(DockBatchGuard)
+    };
+
+    // Grid cell (row, column) of each bar, indexed like `edge2index`
+    static const int barCells[4][2] = {
+        {1, 0},
+        {0, 1},
+        {1, 2},
+        {2, 1},
+    };
+
+    inline Qt::Edge index2edge(int index) {
+        static const Qt::Edge edges[] = {
+            Qt::LeftEdge,
+            Qt::TopEdge,
+            Qt::RightEdge,
+            Qt::BottomEdge,
+        };
+        return edges[index];
+    }
+
     inline int edge2index(Qt::Edge e) {
         int res = 0;
         switch (e) {
@@ -16,6 +16,7 @@ namespace JBDS {
         DockPinned,
         Floating,
         Window,
+        Undocked, // Overlay on top of the central widget, hidden when it loses focus
     };
     Q_ENUM_NS(ViewMode)
 
@@ -0,0 +1,114 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef JBDSPERF_P_H
+#define JBDSPERF_P_H
+
+//
+//  W A R N I N G !!!
+//  -----------------
+//
+// This file is not part of the JetBrainsDockingSystem API. It is used purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or may even be removed.
+//
+
+#include <atomic>
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+#include <JetBrainsDockingSystem/jbdsglobal.h>
+
+namespace JBDS {
+
+    // Enable with QT_LOGGING_RULES="jbds.perf.debug=true" or DockTracer::setEnabled()
+    Q_DECLARE_LOGGING_CATEGORY(jbdsPerf)
+
+    // Set by DockTracer::setEnabled(), which leaves the logging rules of the application alone
+    extern std::atomic<bool> traceEnabled;
+
+    // Readers of the trace inside the process, e.g. the performance overlay
+    extern std::atomic<int> traceListeners;
+
+    inline bool perfEnabled() {
+        return traceEnabled.load(std::memory_order_relaxed) ||
+               traceListeners.load(std::memory_order_relaxed) > 0 ||
+               jbdsPerf().isDebugEnabled();
+    }
+
+    // Microseconds of the steady clock, shared with other tracers using it
+    qint64 traceTimestamp();
+
+    // Appends a complete event to the buffer of the calling thread, without locking
+    void traceComplete(const char *name, qint64 begin, qint64 end, const QString &detail = {});
+
+    struct DockTraceSpan {
+        const char *name = nullptr;
+        qint64 begin = 0;
+        qint64 end = 0;
+    };
+
+    // Latest events of the calling thread whose name starts with the prefix, newest first
+    int recentTraceSpans(const char *prefix, DockTraceSpan *spans, int max);
+
+    // Records the scope as a trace event, costs a flag test while tracing is disabled
+    class DockTraceScope {
+    public:
+        explicit inline DockTraceScope(const char *name)
+            : m_name(name), m_begin(perfEnabled() ? traceTimestamp() : -1) {
+        }
+
+        inline ~DockTraceScope() {
+            if (m_begin >= 0)
+                traceComplete(m_name, m_begin, traceTimestamp());
+        }
+
+    private:
+        const char *m_name;
+        qint64 m_begin;
+
+        Q_DISABLE_COPY(DockTraceScope)
+    };
+
+    // A trace scope that is also logged, with a detail only computed when enabled
+    class DockPerfTimer {
+    public:
+        explicit DockPerfTimer(const char *what)
+            : m_what(what), m_begin(perfEnabled() ? traceTimestamp() : -1) {
+        }
+
+        ~DockPerfTimer() {
+            if (m_begin < 0)
+                return;
+            auto end = traceTimestamp();
+            traceComplete(m_what, m_begin, end, m_detail);
+            qCDebug(jbdsPerf).noquote() << m_what << m_detail << end - m_begin << "us";
+        }
+
+        inline bool isEnabled() const {
+            return m_begin >= 0;
+        }
+
+        inline void setDetail(const QString &detail) {
+            m_detail = detail;
+        }
+
+    private:
+        const char *m_what;
+        qint64 m_begin;
+        QString m_detail;
+
+        Q_DISABLE_COPY(DockPerfTimer)
+    };
+
+}
+
+// Define JBDS_NO_TRACE to compile the trace points out entirely
+#ifdef JBDS_NO_TRACE
+#  define JBDS_TRACE_SCOPE(name)
+#else
+#  define JBDS_TRACE_SCOPE(name) JBDS::DockTraceScope jbdsTraceScope(name)
+#endif
+
+#endif // JBDSPERF_P_H
@@ -0,0 +1,172 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#include "jbdstrace.h"
+#include "jbdsperf_p.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+namespace JBDS {
+
+    Q_LOGGING_CATEGORY(jbdsPerf, "jbds.perf", QtWarningMsg)
+
+    std::atomic<bool> traceEnabled{false};
+    std::atomic<int> traceListeners{0};
+
+    struct DockTraceRecord {
+        const char *name = nullptr;
+        qint64 begin = 0;
+        qint64 end = 0;
+        QString detail;
+    };
+
+    // Written by its thread only, readers see the records published by `written`
+    struct DockTraceBuffer {
+        static constexpr quint64 capacity = 1 << 16;
+
+        std::vector<DockTraceRecord> records = std::vector<DockTraceRecord>(capacity);
+        std::atomic<quint64> written{0};
+        int tid = 0;
+        QString threadName;
+    };
+
+    struct DockTraceRegistry {
+        QMutex mutex;
+        std::vector<std::unique_ptr<DockTraceBuffer>> buffers;
+
+        static DockTraceRegistry &instance() {
+            static DockTraceRegistry registry;
+            return registry;
+        }
+    };
+
+    // The lock is only taken the first time a thread traces
+    static DockTraceBuffer *threadBuffer() {
+        thread_local DockTraceBuffer *buffer = nullptr;
+        if (!buffer) {
+            auto &registry = DockTraceRegistry::instance();
+            QMutexLocker locker(&registry.mutex);
+            registry.buffers.push_back(std::make_unique<DockTraceBuffer>());
+            buffer = registry.buffers.back().get();
+            buffer->tid = int(registry.buffers.size());
+            buffer->threadName = QThread::currentThread()->objectName();
+        }
+        return buffer;
+    }
+
+    qint64 traceTimestamp() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void traceComplete(const char *name, qint64 begin, qint64 end, const QString &detail) {
+        auto buffer = threadBuffer();
+        auto n = buffer->written.load(std::memory_order_relaxed);
+        auto &record = buffer->records[n % DockTraceBuffer::capacity];
+        record.name = name;
+        record.begin = begin;
+        record.end = end;
+        record.detail = detail;
+        buffer->written.store(n + 1, std::memory_order_release);
+    }
+
+    int recentTraceSpans(const char *prefix, DockTraceSpan *spans, int max) {
+        auto buffer = threadBuffer();
+        auto written = buffer->written.load(std::memory_order_relaxed);
+
+        // Bounded, the matching events may be buried under drag moves
+        auto prefixLength = strlen(prefix);
+        auto last = (written > 4096) ? written - 4096 : quint64(0);
+        int count = 0;
+        for (auto i = written; i > last && count < max; --i) {
+            const auto &record = buffer->records[(i - 1) % DockTraceBuffer::capacity];
+            if (strncmp(record.name, prefix, prefixLength) != 0)
+                continue;
+            spans[count++] = {record.name, record.begin, record.end};
+        }
+        return count;
+    }
+
+    bool DockTracer::isEnabled() {
+        return perfEnabled();
+    }
+
+    void DockTracer::setEnabled(bool on) {
+        traceEnabled.store(on, std::memory_order_relaxed);
+    }
+
+    void DockTracer::clear() {
+        auto &registry = DockTraceRegistry::instance();
+        QMutexLocker locker(&registry.mutex);
+        for (const auto &buffer : registry.buffers) {
+            buffer->written.store(0, std::memory_order_release);
+        }
+    }
+
+    QByteArray DockTracer::toChromeJson() {
+        auto &registry = DockTraceRegistry::instance();
+        QMutexLocker locker(&registry.mutex);
+
+        auto pid = QCoreApplication::applicationPid();
+        QJsonArray events;
+        for (const auto &buffer : registry.buffers) {
+            if (!buffer->threadName.isEmpty()) {
+                events.append(QJsonObject{
+                    {"name", "thread_name"},
+                    {"ph", "M"},
+                    {"pid", pid},
+                    {"tid", buffer->tid},
+                    {"args", QJsonObject{{"name", buffer->threadName}}},
+                });
+            }
+
+            // Only the latest records survive a wrapped ring
+            auto written = buffer->written.load(std::memory_order_acquire);
+            auto first = (written > DockTraceBuffer::capacity)
+                             ? written - DockTraceBuffer::capacity
+                             : quint64(0);
+            for (auto i = first; i < written; ++i) {
+                const auto &record = buffer->records[i % DockTraceBuffer::capacity];
+                QJsonObject event{
+                    {"name", QString::fromLatin1(record.name)},
+                    {"cat", "jbds"},
+                    {"ph", "X"},
+                    {"ts", record.begin},
+                    {"dur", record.end - record.begin},
+                    {"pid", pid},
+                    {"tid", buffer->tid},
+                };
+                if (!record.detail.isEmpty()) {
+                    event.insert("args", QJsonObject{{"detail", record.detail}});
+                }
+                events.append(event);
+            }
+        }
+
+        QJsonObject root{
+            {"traceEvents", events},
+            {"displayTimeUnit", "ms"},
+        };
+        return QJsonDocument(root).toJson(QJsonDocument::Compact);
+    }
+
+    bool DockTracer::saveChromeJson(const QString &fileName) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        return file.write(toChromeJson()) >= 0;
+    }
+
+}
@@ -0,0 +1,31 @@
+// Copyright (C) 2023-2024 Stdware Collections (https://www.github.com/stdware)
+// SPDX-License-Identifier: MIT
+
+#ifndef JBDSTRACE_H
+#define JBDSTRACE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <JetBrainsDockingSystem/jbdsglobal.h>
+
+namespace JBDS {
+
+    // Trace points of the library, recorded while enabled here or while the jbds.perf category
+    // has debug output. Every thread writes to its own ring buffer of the latest 65536 events.
+    // Timestamps come from std::chrono::steady_clock, so the Chrome trace-event JSON lines
+    // up with other traces taken on the same clock when loaded in Perfetto or chrome://tracing.
+    class JBDS_EXPORT DockTracer {
+    public:
+        static bool isEnabled();
+        static void setEnabled(bool on);
+
+        // Call these while no thread is tracing, e.g. after disabling
+        static void clear();
+        static QByteArray toChromeJson();
+        static bool saveChromeJson(const QString &fileName);
+    };
+
+}
+
+#endif // JBDSTRACE_H
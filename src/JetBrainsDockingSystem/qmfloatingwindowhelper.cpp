@@ -9,6 +9,8 @@
 #include <QTimer>
 #include <QWidget>
 
+#include "jbdsperf_p.h"
+
 class QMFloatingWindowHelperPrivate : public QObject {
 public:
     QMFloatingWindowHelperPrivate(QWidget *w, QMFloatingWindowHelper *q);
@@ -33,6 +35,7 @@ public:
 
     QWidget *w;
     QMargins m_resizeMargins;
+    std::atomic<quint64> *m_eventCounter = nullptr;
 
     bool m_floating;
     int m_windowFlags;
@@ -85,6 +88,7 @@ QMFloatingWindowHelperPrivate::~QMFloatingWindowHelperPrivate() {
 }
 
 void QMFloatingWindowHelperPrivate::setFloating_helper(bool floating, Qt::WindowFlags flags) {
+    JBDS_TRACE_SCOPE("QMFloatingWindowHelper::setFloating");
     m_floating = floating;
 
     if (floating) {
@@ -244,6 +248,7 @@ bool QMFloatingWindowHelperPrivate::dummyEventFilter(QObject *obj, QEvent *event
             }
 
             if (curRect != m_rect) {
+                JBDS_TRACE_SCOPE("QMFloatingWindowHelper::setGeometry");
                 m_rect = curRect;
                 w->setGeometry(curRect);
             }
@@ -308,6 +313,9 @@ bool QMFloatingWindowHelperPrivate::dummyEventFilter(QObject *obj, QEvent *event
 }
 
 bool QMFloatingWindowHelperPrivate::eventFilter(QObject *obj, QEvent *event) {
+    if (m_eventCounter) {
+        m_eventCounter->fetch_add(1, std::memory_order_relaxed);
+    }
     if (obj == w) {
         if (dummyEventFilter(obj, event)) {
             return true;
@@ -368,4 +376,8 @@ QMargins QMFloatingWindowHelper::resizeMargins() const {
 
 void QMFloatingWindowHelper::setResizeMargins(const QMargins &resizeMargins) {
     d->m_resizeMargins = resizeMargins;
+}
+
+void QMFloatingWindowHelper::setEventCounter(std::atomic<quint64> *counter) {
+    d->m_eventCounter = counter;
 }
\ No newline at end of file
@@ -13,6 +13,8 @@
 // version without notice, or may even be removed.
 //
 
+#include <atomic>
+
 #include <QMargins>
 #include <QObject>
 
@@ -33,6 +35,9 @@ public:
     QMargins resizeMargins() const;
     void setResizeMargins(const QMargins &resizeMargins);
 
+    // Counts the events seen by the filters of the helper
+    void setEventCounter(std::atomic<quint64> *counter);
+
 private:
     QMFloatingWindowHelperPrivate *d;
 };
@@ -0,0 +1,196 @@
+#include "DockBenchmark.h"
+
+#include <QApplication>
+#include <QLabel>
+#include <QtTest/QtTest>
+
+#include "DragHelper.h"
+
+using namespace JBDS;
+
+static const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+
+DockBenchmark::DockBenchmark(QObject *parent) : QObject(parent), dock(nullptr) {
+}
+
+DockBenchmark::~DockBenchmark() {
+}
+
+void DockBenchmark::init() {
+    QFETCH(int, count);
+    createDock(count);
+}
+
+void DockBenchmark::cleanup() {
+    delete dock;
+    dock = nullptr;
+    buttons.clear();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+void DockBenchmark::insertRemove_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::insertRemove() {
+    QBENCHMARK {
+        auto label = new QLabel("extra");
+        auto button = dock->addWidget(Qt::LeftEdge, Front, label);
+        button->setChecked(true);
+        dock->removeWidget(button);
+        delete label;
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+}
+
+void DockBenchmark::moveWidget_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::moveWidget() {
+    auto button = buttons.first();
+    int i = 0;
+    QBENCHMARK {
+        dock->moveWidget(button, (i++ % 2) ? Qt::LeftEdge : Qt::RightEdge, Back, 0);
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::toggle_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::toggle() {
+    auto button = buttons.first();
+    QBENCHMARK {
+        button->toggle();
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::switchViewMode_data() {
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("viewMode");
+    QTest::addColumn<int>("policy");
+    QTest::newRow("undocked") << 100 << int(Undocked) << int(DockWidget::RecreateWindow);
+    QTest::newRow("floating") << 100 << int(Floating) << int(DockWidget::RecreateWindow);
+    QTest::newRow("window") << 100 << int(Window) << int(DockWidget::RecreateWindow);
+    QTest::newRow("floating-pooled") << 100 << int(Floating) << int(DockWidget::PooledWindow);
+    QTest::newRow("window-pooled") << 100 << int(Window) << int(DockWidget::PooledWindow);
+}
+
+void DockBenchmark::switchViewMode() {
+    QFETCH(int, viewMode);
+    QFETCH(int, policy);
+
+    auto button = buttons.first();
+    dock->setWindowPolicy(button, DockWidget::WindowPolicy(policy));
+    QBENCHMARK {
+        dock->setViewMode(button, ViewMode(viewMode));
+        QCoreApplication::processEvents();
+        dock->setViewMode(button, DockPinned);
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::setEdgeSize_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::setEdgeSize() {
+    int i = 0;
+    QBENCHMARK {
+        dock->setEdgeSize(Qt::LeftEdge, (i++ % 2) ? 200 : 300);
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::toggleMaximize_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::toggleMaximize() {
+    QBENCHMARK {
+        dock->toggleMaximize(Qt::BottomEdge);
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::drag_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::drag() {
+    auto button = buttons.first();
+    auto leftBar = dock->findChild<QWidget *>("left-bar");
+    auto rightBar = dock->findChild<QWidget *>("right-bar");
+    QVERIFY(leftBar && rightBar);
+
+    int i = 0;
+    QBENCHMARK {
+        QVERIFY2(dragButton(button, (i++ % 2) ? leftBar : rightBar), "no drag started");
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::floatingWindowEvents_data() {
+    QTest::addColumn<int>("count");
+    QTest::newRow("1") << 1;
+    QTest::newRow("10") << 10;
+    QTest::newRow("50") << 50;
+}
+
+void DockBenchmark::floatingWindowEvents() {
+    // Every tool window floats, one of them is moved around
+    for (auto button : std::as_const(buttons)) {
+        dock->setViewMode(button, Floating);
+        button->setChecked(true);
+    }
+    QCoreApplication::processEvents();
+
+    auto window = dock->widget(buttons.first());
+    QVERIFY(window && window->isWindow());
+
+    int i = 0;
+    QBENCHMARK {
+        window->move(100 + (i++ % 2) * 20, 100);
+        window->resize(300 + (i % 2) * 20, 200);
+        QCoreApplication::processEvents();
+    }
+}
+
+void DockBenchmark::sideBarRepaint_data() {
+    addCountColumn();
+}
+
+void DockBenchmark::sideBarRepaint() {
+    auto bar = dock->findChild<QWidget *>("left-bar");
+    QVERIFY(bar);
+    QBENCHMARK {
+        bar->repaint();
+    }
+}
+
+void DockBenchmark::addCountColumn() {
+    QTest::addColumn<int>("count");
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void DockBenchmark::createDock(int count) {
+    dock = new DockWidget();
+    dock->setWidget(new QLabel("central"));
+    dock->resize(1280, 720);
+
+    for (int i = 0; i < count; ++i) {
+        auto text = QString("tool-%1").arg(i);
+        auto button = dock->addWidget(edges[i % 4], (i % 8 < 4) ? Front : Back, new QLabel(text));
+        button->setText(text);
+        buttons.append(button);
+    }
+    buttons.first()->setChecked(true);
+
+    dock->show();
+    QCoreApplication::processEvents();
+}
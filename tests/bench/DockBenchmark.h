@@ -0,0 +1,46 @@
+#ifndef DOCKBENCHMARK_H
+#define DOCKBENCHMARK_H
+
+#include <QObject>
+
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+// Hot paths of the dock against the number of tool windows
+class DockBenchmark : public QObject {
+    Q_OBJECT
+public:
+    explicit DockBenchmark(QObject *parent = nullptr);
+    ~DockBenchmark();
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void insertRemove_data();
+    void insertRemove();
+    void moveWidget_data();
+    void moveWidget();
+    void toggle_data();
+    void toggle();
+    void switchViewMode_data();
+    void switchViewMode();
+    void setEdgeSize_data();
+    void setEdgeSize();
+    void toggleMaximize_data();
+    void toggleMaximize();
+    void drag_data();
+    void drag();
+    void floatingWindowEvents_data();
+    void floatingWindowEvents();
+    void sideBarRepaint_data();
+    void sideBarRepaint();
+
+private:
+    JBDS::DockWidget *dock;
+    QList<QAbstractButton *> buttons;
+
+    void addCountColumn();
+    void createDock(int count);
+};
+
+#endif // DOCKBENCHMARK_H
@@ -0,0 +1,115 @@
+#include "PerspectiveBenchmark.h"
+
+#include <QLabel>
+#include <QtTest/QtTest>
+
+using namespace JBDS;
+
+static const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+
+PerspectiveBenchmark::PerspectiveBenchmark(QObject *parent) : QObject(parent), dock(nullptr) {
+}
+
+PerspectiveBenchmark::~PerspectiveBenchmark() {
+}
+
+void PerspectiveBenchmark::init() {
+    QFETCH(int, count);
+    createDock(count);
+}
+
+void PerspectiveBenchmark::cleanup() {
+    delete dock;
+    dock = nullptr;
+    buttons.clear();
+    layouts[0] = {};
+    layouts[1] = {};
+}
+
+void PerspectiveBenchmark::switchPerspective_data() {
+    QTest::addColumn<int>("count");
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+}
+
+void PerspectiveBenchmark::switchPerspective() {
+    QVERIFY(dock->addPerspective("debug", layouts[0]));
+    QVERIFY(dock->addPerspective("review", layouts[1]));
+
+    int i = 0;
+    QBENCHMARK {
+        dock->setCurrentPerspective((i++ % 2) ? "debug" : "review");
+        QCoreApplication::processEvents();
+    }
+}
+
+void PerspectiveBenchmark::replayCalls_data() {
+    switchPerspective_data();
+}
+
+void PerspectiveBenchmark::replayCalls() {
+    int i = 0;
+    QBENCHMARK {
+        replay(layouts[(i++ % 2) ? 0 : 1]);
+        QCoreApplication::processEvents();
+    }
+}
+
+void PerspectiveBenchmark::createDock(int count) {
+    dock = new DockWidget();
+    dock->setWidget(new QLabel("central"));
+    dock->resize(1280, 720);
+
+    // "debug" keeps everything on the left and bottom, "review" rotates every third
+    // tool window to the opposite edge and shows another one per stripe side
+    QList<DockLayout::Item> items[2][8];
+    for (int i = 0; i < count; ++i) {
+        auto id = QString("tool-%1").arg(i);
+        auto edge = (i % 2) ? Qt::BottomEdge : Qt::LeftEdge;
+        auto side = (i % 4 < 2) ? Front : Back;
+        auto button = dock->addWidget(edge, side, id, [id]() {
+            auto label = new QLabel(id);
+            label->setObjectName(id);
+            return label;
+        });
+        button->setText(id);
+        buttons.insert(id, button);
+
+        int list = ((i % 2) ? 6 : 0) + side;
+        items[0][list].append({id, DockPinned, i < 4});
+
+        int otherList = (i % 3 == 0) ? ((i % 2) ? 2 : 4) + side : list;
+        items[1][otherList].append({id, DockPinned, false});
+    }
+    for (auto &list : items[1]) {
+        if (!list.isEmpty())
+            list.last().visible = true;
+    }
+
+    for (int k = 0; k < 2; ++k) {
+        for (int list = 0; list < 8; ++list) {
+            layouts[k].setItems(edges[list / 2], Side(list % 2), items[k][list]);
+        }
+    }
+
+    dock->applyLayout(layouts[0]);
+    dock->show();
+    QCoreApplication::processEvents();
+}
+
+void PerspectiveBenchmark::replay(const DockLayout &layout) {
+    // What an application does without perspectives: tear down and rebuild every stripe
+    for (auto edge : edges) {
+        for (auto side : {Front, Back}) {
+            auto items = layout.items(edge, side);
+            for (int i = 0; i < items.size(); ++i) {
+                auto button = buttons.value(items.at(i).id);
+                if (!button)
+                    continue;
+                dock->moveWidget(button, edge, side, i);
+                dock->setViewMode(button, items.at(i).viewMode);
+                button->setChecked(items.at(i).visible);
+            }
+        }
+    }
+}
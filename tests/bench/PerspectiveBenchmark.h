@@ -0,0 +1,33 @@
+#ifndef PERSPECTIVEBENCHMARK_H
+#define PERSPECTIVEBENCHMARK_H
+
+#include <QHash>
+#include <QObject>
+
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+class PerspectiveBenchmark : public QObject {
+    Q_OBJECT
+public:
+    explicit PerspectiveBenchmark(QObject *parent = nullptr);
+    ~PerspectiveBenchmark();
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void switchPerspective_data();
+    void switchPerspective();
+    void replayCalls_data();
+    void replayCalls();
+
+private:
+    JBDS::DockWidget *dock;
+    JBDS::DockLayout layouts[2];
+    QHash<QString, QAbstractButton *> buttons;
+
+    void createDock(int count);
+    void replay(const JBDS::DockLayout &layout);
+};
+
+#endif // PERSPECTIVEBENCHMARK_H
@@ -0,0 +1,178 @@
+#include "QueryBenchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <QLabel>
+#include <QtTest/QtTest>
+
+using namespace JBDS;
+
+// Allocations of the GUI thread while counting. With glibc every malloc of the process is
+// seen, Qt containers included, elsewhere only operator new of this executable.
+static std::atomic<qint64> allocationCount{0};
+static thread_local bool counting = false;
+
+#ifdef __GLIBC__
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) {
+    if (counting)
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    if (counting)
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    if (counting)
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+void *operator new(std::size_t size) {
+    if (counting)
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
+static const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+
+enum Query {
+    WidgetsQuery,
+    ForEachQuery,
+    SizesListQuery,
+    SizesArrayQuery,
+    EdgeSizeQuery,
+    ViewModeQuery,
+};
+
+QueryBenchmark::QueryBenchmark(QObject *parent) : QObject(parent), dock(nullptr) {
+}
+
+QueryBenchmark::~QueryBenchmark() {
+}
+
+void QueryBenchmark::init() {
+    QFETCH(int, count);
+
+    dock = new DockWidget();
+    dock->setWidget(new QLabel("central"));
+    dock->resize(1280, 720);
+    for (int i = 0; i < count; ++i) {
+        auto text = QString("tool-%1").arg(i);
+        dock->addWidget(edges[i % 4], (i % 8 < 4) ? Front : Back, new QLabel(text))
+            ->setText(text);
+    }
+    dock->show();
+    QCoreApplication::processEvents();
+}
+
+void QueryBenchmark::cleanup() {
+    delete dock;
+    dock = nullptr;
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+void QueryBenchmark::allocations_data() {
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("query");
+    QTest::addColumn<bool>("allocationFree");
+
+    const struct {
+        const char *name;
+        Query query;
+        bool allocationFree;
+    } queries[] = {
+        {"widgets", WidgetsQuery, false},
+        {"forEachToolWindow", ForEachQuery, true},
+        {"orientationSizes-list", SizesListQuery, false},
+        {"orientationSizes-array", SizesArrayQuery, true},
+        {"edgeSize", EdgeSizeQuery, true},
+        {"viewMode", ViewModeQuery, true},
+    };
+    for (int count : {10, 100, 1000}) {
+        for (const auto &item : queries) {
+            QTest::addRow("%s-%d", item.name, count) << count << int(item.query)
+                                                  << item.allocationFree;
+        }
+    }
+}
+
+void QueryBenchmark::allocations() {
+    QFETCH(int, query);
+    QFETCH(bool, allocationFree);
+
+    auto first = dock->widgets(Qt::LeftEdge, Front).first();
+    auto button = static_cast<QAbstractButton *>(dock->findButton(first));
+    int sink = 0;
+    auto run = [&]() {
+        switch (Query(query)) {
+            case WidgetsQuery:
+                for (auto edge : edges) {
+                    sink += int(dock->widgets(edge, Front).size());
+                }
+                break;
+            case ForEachQuery:
+                for (auto edge : edges) {
+                    dock->forEachToolWindow(edge, Front, [&sink](QAbstractButton *, QWidget *w) {
+                        sink += (w != nullptr);
+                    });
+                }
+                break;
+            case SizesListQuery:
+                sink += dock->orientationSizes(Qt::Horizontal).at(1);
+                break;
+            case SizesArrayQuery: {
+                int sizes[3];
+                dock->orientationSizes(Qt::Horizontal, sizes);
+                sink += sizes[1];
+                break;
+            }
+            case EdgeSizeQuery:
+                sink += dock->edgeSize(Qt::LeftEdge);
+                break;
+            case ViewModeQuery:
+                sink += int(dock->viewMode(button));
+                break;
+        }
+    };
+
+    // Lazily created state is not part of the query
+    run();
+
+    const int repeats = 1000;
+    allocationCount.store(0);
+    counting = true;
+    for (int i = 0; i < repeats; ++i) {
+        run();
+    }
+    counting = false;
+    Q_UNUSED(sink)
+
+    auto perQuery = double(allocationCount.load()) / repeats;
+    if (allocationFree) {
+        QCOMPARE(perQuery, 0.0);
+    }
+    QTest::setBenchmarkResult(perQuery, QTest::Events);
+}
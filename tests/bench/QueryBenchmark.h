@@ -0,0 +1,26 @@
+#ifndef QUERYBENCHMARK_H
+#define QUERYBENCHMARK_H
+
+#include <QObject>
+
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+// Heap allocations made by the read-only queries of the dock, per query
+class QueryBenchmark : public QObject {
+    Q_OBJECT
+public:
+    explicit QueryBenchmark(QObject *parent = nullptr);
+    ~QueryBenchmark();
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void allocations_data();
+    void allocations();
+
+private:
+    JBDS::DockWidget *dock;
+};
+
+#endif // QUERYBENCHMARK_H
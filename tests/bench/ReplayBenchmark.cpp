@@ -0,0 +1,79 @@
+#include "ReplayBenchmark.h"
+
+#include <QDir>
+#include <QLabel>
+#include <QtTest/QtTest>
+
+#include <JetBrainsDockingSystem/dockinputtrace.h>
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+using namespace JBDS;
+
+ReplayBenchmark::ReplayBenchmark(QObject *parent) : QObject(parent) {
+}
+
+ReplayBenchmark::~ReplayBenchmark() {
+}
+
+void ReplayBenchmark::replay_data() {
+    QTest::addColumn<QString>("fileName");
+
+    QFileInfoList traces;
+    if (auto path = qEnvironmentVariable("JBDS_REPLAY_TRACES"); !path.isEmpty()) {
+        traces = QDir(path).entryInfoList({"*.jbdt"}, QDir::Files, QDir::Name);
+    }
+    if (traces.isEmpty()) {
+        QTest::newRow("none") << QString();
+    }
+    for (const auto &info : std::as_const(traces)) {
+        QTest::newRow(qPrintable(info.completeBaseName())) << info.filePath();
+    }
+}
+
+void ReplayBenchmark::replay() {
+    QFETCH(QString, fileName);
+    if (fileName.isEmpty()) {
+        QSKIP("JBDS_REPLAY_TRACES does not name a directory holding .jbdt traces");
+    }
+
+    DockInputReplayer replayer;
+    QVERIFY2(replayer.load(fileName), qPrintable(fileName));
+
+    // Same tool windows in the same places, with placeholder contents
+    DockWidget dock;
+    dock.setWidget(new QLabel("central"));
+    auto layout = replayer.layout();
+    const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+    for (auto edge : edges) {
+        for (auto side : {Front, Back}) {
+            for (const auto &item : layout.items(edge, side)) {
+                auto id = item.id;
+                dock.addWidget(edge, side, id, [id]() {
+                    return new QLabel(id); //
+                })->setText(id);
+            }
+        }
+    }
+    dock.resize(replayer.dockSize());
+    dock.show();
+    dock.applyLayout(layout);
+    QCoreApplication::processEvents();
+
+    auto report = replayer.replay(&dock, DockInputReplayer::MaximumSpeed);
+    QTest::setBenchmarkResult(report.elapsed / 1000.0, QTest::WalltimeMilliseconds);
+
+    QList<qint64> times;
+    for (const auto &sample : std::as_const(report.samples)) {
+        times.append(sample.usecs);
+    }
+    std::sort(times.begin(), times.end());
+    auto at = [&times](double p) {
+        return times.isEmpty() ? 0 : times.at(qMin(times.size() - 1, int(times.size() * p)));
+    };
+    qInfo().noquote() << QString("events=%1 skipped=%2 frames=%3 p50=%4 p99=%5 us")
+                             .arg(report.events)
+                             .arg(report.skipped)
+                             .arg(report.frames)
+                             .arg(at(0.5))
+                             .arg(at(0.99));
+}
@@ -0,0 +1,18 @@
+#ifndef REPLAYBENCHMARK_H
+#define REPLAYBENCHMARK_H
+
+#include <QObject>
+
+// Replays the input traces found in $JBDS_REPLAY_TRACES, see DockInputRecorder
+class ReplayBenchmark : public QObject {
+    Q_OBJECT
+public:
+    explicit ReplayBenchmark(QObject *parent = nullptr);
+    ~ReplayBenchmark();
+
+private Q_SLOTS:
+    void replay_data();
+    void replay();
+};
+
+#endif // REPLAYBENCHMARK_H
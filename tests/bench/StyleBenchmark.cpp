@@ -0,0 +1,92 @@
+#include "StyleBenchmark.h"
+
+#include <QLabel>
+#include <QtTest/QtTest>
+
+using namespace JBDS;
+
+// Same look twice: the style sheet the demo used to ship and the typed properties
+static const char dockStyleSheet[] = R"(
+JBDS--DockWidget {
+    background-color: transparent;
+}
+
+JBDS--DockWidget>JBDS--DockSideBar {
+    padding: 3px;
+    background-color: transparent;
+    qproperty-buttonSpacing: 6;
+    qproperty-highlightColor: #f3f3f3;
+}
+
+JBDS--DockWidget QSplitter#dock-splitter:handle {
+    background-color: red;
+}
+
+JBDS--DockWidget JBDS--DockPanel:handle {
+    background-color: red;
+}
+)";
+
+StyleBenchmark::StyleBenchmark(QObject *parent) : QObject(parent) {
+}
+
+StyleBenchmark::~StyleBenchmark() {
+}
+
+void StyleBenchmark::startup_data() {
+    QTest::addColumn<bool>("styleSheet");
+    QTest::newRow("qss") << true;
+    QTest::newRow("native") << false;
+}
+
+void StyleBenchmark::startup() {
+    QFETCH(bool, styleSheet);
+
+    QBENCHMARK {
+        auto dock = createDock(styleSheet);
+        dock->show();
+        QCoreApplication::processEvents();
+        delete dock;
+    }
+}
+
+void StyleBenchmark::repaint_data() {
+    startup_data();
+}
+
+void StyleBenchmark::repaint() {
+    QFETCH(bool, styleSheet);
+
+    auto dock = createDock(styleSheet);
+    dock->show();
+    QCoreApplication::processEvents();
+
+    QBENCHMARK {
+        dock->repaint();
+    }
+    delete dock;
+}
+
+DockWidget *StyleBenchmark::createDock(bool styleSheet) {
+    auto dock = new DockWidget();
+    if (styleSheet) {
+        dock->setStyleSheet(dockStyleSheet);
+    } else {
+        dock->setBarPadding(3);
+        dock->setButtonSpacing(6);
+        dock->setHighlightColor(QColor(0xf3, 0xf3, 0xf3));
+        dock->setHandleColor(Qt::red);
+    }
+
+    dock->setWidget(new QLabel("central"));
+    dock->resize(1280, 720);
+
+    const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+    for (int i = 0; i < 40; ++i) {
+        auto text = QString("tool-%1").arg(i);
+        auto button = dock->addWidget(edges[i % 4], (i % 8 < 4) ? Front : Back, new QLabel(text));
+        button->setText(text);
+        button->setChecked(i < 8);
+    }
+    return dock;
+}
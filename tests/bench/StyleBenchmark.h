@@ -0,0 +1,24 @@
+#ifndef STYLEBENCHMARK_H
+#define STYLEBENCHMARK_H
+
+#include <QObject>
+
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+class StyleBenchmark : public QObject {
+    Q_OBJECT
+public:
+    explicit StyleBenchmark(QObject *parent = nullptr);
+    ~StyleBenchmark();
+
+private Q_SLOTS:
+    void startup_data();
+    void startup();
+    void repaint_data();
+    void repaint();
+
+private:
+    JBDS::DockWidget *createDock(bool styleSheet);
+};
+
+#endif // STYLEBENCHMARK_H
@@ -0,0 +1,68 @@
+#include "SwitcherBenchmark.h"
+
+#include <QLabel>
+#include <QtTest/QtTest>
+
+using namespace JBDS;
+
+static const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+
+SwitcherBenchmark::SwitcherBenchmark(QObject *parent) : QObject(parent), dock(nullptr) {
+}
+
+SwitcherBenchmark::~SwitcherBenchmark() {
+}
+
+void SwitcherBenchmark::init() {
+    QFETCH(int, count);
+
+    dock = new DockWidget();
+    dock->setWidget(new QLabel("central"));
+    dock->resize(1280, 720);
+    for (int i = 0; i < count; ++i) {
+        auto id = QString("tool-%1").arg(i);
+        auto button = dock->addWidget(edges[i % 4], (i % 8 < 4) ? Front : Back, id, [id]() {
+            return new QLabel(id); //
+        });
+        button->setText(QString("Tool Window %1").arg(i));
+    }
+    dock->show();
+    QCoreApplication::processEvents();
+}
+
+void SwitcherBenchmark::cleanup() {
+    delete dock;
+    dock = nullptr;
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+void SwitcherBenchmark::typing_data() {
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("best");
+
+    for (int count : {100, 1000}) {
+        QTest::addRow("initials-%d", count) << count << "tw99" << "Tool Window 99";
+        QTest::addRow("words-%d", count) << count << "window 99" << "Tool Window 99";
+        QTest::addRow("id-%d", count) << count << "tool-42" << "Tool Window 42";
+        QTest::addRow("none-%d", count) << count << "zq" << QString();
+    }
+}
+
+// The whole pattern typed one character after another, each prefix searched like the
+// switcher does on every keystroke
+void SwitcherBenchmark::typing() {
+    QFETCH(QString, pattern);
+    QFETCH(QString, best);
+
+    auto res = dock->findToolWindows(pattern, 1);
+    QCOMPARE(res.isEmpty() ? QString() : res.first()->text(), best);
+
+    int sink = 0;
+    QBENCHMARK {
+        for (int i = 1; i <= pattern.size(); ++i) {
+            sink += dock->findToolWindows(pattern.left(i), 50).size();
+        }
+    }
+    Q_UNUSED(sink)
+}
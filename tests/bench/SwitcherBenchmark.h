@@ -0,0 +1,26 @@
+#ifndef SWITCHERBENCHMARK_H
+#define SWITCHERBENCHMARK_H
+
+#include <QObject>
+
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+// Finding tool windows by what the user types
+class SwitcherBenchmark : public QObject {
+    Q_OBJECT
+public:
+    explicit SwitcherBenchmark(QObject *parent = nullptr);
+    ~SwitcherBenchmark();
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void typing_data();
+    void typing();
+
+private:
+    JBDS::DockWidget *dock;
+};
+
+#endif // SWITCHERBENCHMARK_H
@@ -0,0 +1,66 @@
+#include <QApplication>
+#include <QDir>
+#include <QtTest/QtTest>
+
+#include "DockBenchmark.h"
+#include "PerspectiveBenchmark.h"
+#include "QueryBenchmark.h"
+#include "ReplayBenchmark.h"
+#include "StyleBenchmark.h"
+#include "SwitcherBenchmark.h"
+
+// Usage: jbds_bench [-results <dir>] [QtTest options]
+//
+// With -results, every benchmark class also writes <dir>/<class>.xml and <dir>/<class>.csv
+// so that runs of different releases can be compared by scripts.
+static int exec(QObject *tc, const QStringList &args, const QString &resultsDir) {
+    auto arguments = args;
+    if (!resultsDir.isEmpty()) {
+        auto base = QDir(resultsDir).filePath(tc->metaObject()->className());
+        arguments << "-o" << base + ".xml,xml" << "-o" << base + ".csv,csv" << "-o" << "-,txt";
+    }
+    return QTest::qExec(tc, arguments);
+}
+
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication a(argc, argv);
+
+    auto args = a.arguments();
+    QString resultsDir;
+    if (int i = args.indexOf("-results"); i > 0 && i + 1 < args.size()) {
+        resultsDir = args.at(i + 1);
+        args.removeAt(i + 1);
+        args.removeAt(i);
+        QDir().mkpath(resultsDir);
+    }
+
+    int status = 0;
+    {
+        DockBenchmark tc;
+        status |= exec(&tc, args, resultsDir);
+    }
+    {
+        PerspectiveBenchmark tc;
+        status |= exec(&tc, args, resultsDir);
+    }
+    {
+        QueryBenchmark tc;
+        status |= exec(&tc, args, resultsDir);
+    }
+    {
+        StyleBenchmark tc;
+        status |= exec(&tc, args, resultsDir);
+    }
+    {
+        SwitcherBenchmark tc;
+        status |= exec(&tc, args, resultsDir);
+    }
+    {
+        ReplayBenchmark tc;
+        status |= exec(&tc, args, resultsDir);
+    }
+    return status;
+}
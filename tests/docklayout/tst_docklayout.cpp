@@ -0,0 +1,302 @@
+#include <algorithm>
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+
+#include <JetBrainsDockingSystem/docklayout_p.h>
+
+using namespace JBDS;
+
+using Operation = DockLayoutOperation;
+
+static const Qt::Edge edges[] = {
+    Qt::LeftEdge,
+    Qt::TopEdge,
+    Qt::RightEdge,
+    Qt::BottomEdge,
+};
+
+static DockLayout::Item item(const QString &id, bool visible = false,
+                             ViewMode viewMode = DockPinned) {
+    DockLayout::Item res;
+    res.id = id;
+    res.visible = visible;
+    res.viewMode = viewMode;
+    return res;
+}
+
+// One hidden pinned tool window per id
+static QList<DockLayout::Item> items(const QStringList &ids) {
+    QList<DockLayout::Item> res;
+    for (const auto &id : ids) {
+        res.append(item(id));
+    }
+    return res;
+}
+
+static bool locate(const DockLayout &layout, const QString &id, int *list, int *index) {
+    for (int i = 0; i < 8; ++i) {
+        auto items = layout.items(edges[i / 2], Side(i % 2));
+        for (int j = 0; j < items.size(); ++j) {
+            if (items.at(j).id == id) {
+                *list = i;
+                *index = j;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Plays an operation the way the dock does, on plain data
+static bool apply(DockLayout &layout, const Operation &op) {
+    if (op.type == Operation::SetSizes) {
+        layout.setOrientationSizes(op.orientation, op.sizes);
+        return true;
+    }
+
+    int list, index;
+    if (!locate(layout, op.id, &list, &index))
+        return false;
+    auto source = layout.items(edges[list / 2], Side(list % 2));
+    switch (op.type) {
+        case Operation::Hide:
+        case Operation::Show:
+            source[index].visible = op.type == Operation::Show;
+            break;
+        case Operation::SetViewMode:
+            source[index].viewMode = op.viewMode;
+            break;
+        case Operation::Move: {
+            auto moved = source.takeAt(index);
+            layout.setItems(edges[list / 2], Side(list % 2), source);
+
+            source = layout.items(op.edge, op.side);
+            int pos = 0;
+            if (!op.afterId.isEmpty()) {
+                pos = -1;
+                for (int j = 0; j < source.size(); ++j) {
+                    if (source.at(j).id == op.afterId)
+                        pos = j + 1;
+                }
+                if (pos < 0)
+                    return false;
+            }
+            source.insert(pos, moved);
+            layout.setItems(op.edge, op.side, source);
+            return true;
+        }
+        default:
+            return false;
+    }
+    layout.setItems(edges[list / 2], Side(list % 2), source);
+    return true;
+}
+
+static DockLayout applied(DockLayout layout, const QList<Operation> &ops) {
+    for (const auto &op : ops) {
+        if (!apply(layout, op))
+            return {};
+    }
+    return layout;
+}
+
+static int count(const QList<Operation> &ops, Operation::Type type) {
+    return int(std::count_if(ops.begin(), ops.end(),
+                             [type](const Operation &op) { return op.type == type; }));
+}
+
+// Quadratic on purpose, independent of the engine
+static int longestIncreasing(const QVector<int> &values) {
+    QVector<int> lengths(values.size(), 1);
+    int res = 0;
+    for (int i = 0; i < values.size(); ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (values[j] < values[i])
+                lengths[i] = qMax(lengths[i], lengths[j] + 1);
+        }
+        res = qMax(res, lengths[i]);
+    }
+    return res;
+}
+
+class tst_DockLayout : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void identity();
+    void singleMove();
+    void moveAcrossLists();
+    void reversal();
+    void operationOrder();
+    void unlistedKeepPlacement();
+    void unknownIdsIgnored();
+
+    void randomMinimal();
+};
+
+void tst_DockLayout::identity() {
+    DockLayout layout;
+    layout.setItems(Qt::LeftEdge, Front, items({"a", "b", "c"}));
+    layout.setItems(Qt::BottomEdge, Back, {item("d", true), item("e", false, Floating)});
+    layout.setOrientationSizes(Qt::Horizontal, {200, 600, 200});
+
+    QVERIFY(diffLayouts(layout, layout).isEmpty());
+    QVERIFY(diffLayouts(DockLayout(), DockLayout()).isEmpty());
+}
+
+void tst_DockLayout::singleMove() {
+    DockLayout from;
+    from.setItems(Qt::LeftEdge, Front, items({"a", "b", "c", "d"}));
+    DockLayout to;
+    to.setItems(Qt::LeftEdge, Front, items({"a", "c", "d", "b"}));
+
+    auto ops = diffLayouts(from, to);
+    QCOMPARE(int(ops.size()), 1);
+    QCOMPARE(ops.first().type, Operation::Move);
+    QCOMPARE(ops.first().id, QString("b"));
+    QCOMPARE(ops.first().afterId, QString("d"));
+    QCOMPARE(applied(from, ops), to);
+
+    // To the front
+    to.setItems(Qt::LeftEdge, Front, items({"d", "a", "b", "c"}));
+    ops = diffLayouts(from, to);
+    QCOMPARE(int(ops.size()), 1);
+    QVERIFY(ops.first().afterId.isEmpty());
+    QCOMPARE(applied(from, ops), to);
+}
+
+void tst_DockLayout::moveAcrossLists() {
+    DockLayout from;
+    from.setItems(Qt::LeftEdge, Front, items({"a", "b", "c"}));
+    from.setItems(Qt::RightEdge, Back, items({"d"}));
+    DockLayout to;
+    to.setItems(Qt::LeftEdge, Front, items({"a", "c"}));
+    to.setItems(Qt::RightEdge, Back, items({"b", "d"}));
+
+    auto ops = diffLayouts(from, to);
+    QCOMPARE(int(ops.size()), 1);
+    QCOMPARE(ops.first().edge, Qt::RightEdge);
+    QCOMPARE(ops.first().side, Back);
+    QCOMPARE(applied(from, ops), to);
+}
+
+void tst_DockLayout::reversal() {
+    QStringList ids{"a", "b", "c", "d", "e", "f"};
+    QStringList reversed(ids.crbegin(), ids.crend());
+
+    DockLayout from;
+    from.setItems(Qt::TopEdge, Front, items(ids));
+    DockLayout to;
+    to.setItems(Qt::TopEdge, Front, items(reversed));
+
+    // Only one tool window can stay where it is
+    auto ops = diffLayouts(from, to);
+    QCOMPARE(count(ops, Operation::Move), int(ids.size()) - 1);
+    QCOMPARE(int(ops.size()), int(ids.size()) - 1);
+    QCOMPARE(applied(from, ops), to);
+}
+
+void tst_DockLayout::operationOrder() {
+    DockLayout from;
+    from.setItems(Qt::LeftEdge, Front, {item("a", true), item("b"), item("c", true)});
+    from.setItems(Qt::BottomEdge, Front, {item("d", false, Floating), item("e", true)});
+    from.setOrientationSizes(Qt::Vertical, {100, 400, 100});
+
+    DockLayout to;
+    to.setItems(Qt::LeftEdge, Front, {item("c"), item("b", true, Window)});
+    to.setItems(Qt::BottomEdge, Front, {item("e", false, Floating), item("a", true)});
+    to.setItems(Qt::RightEdge, Back, {item("d", true)});
+    to.setOrientationSizes(Qt::Vertical, {150, 300, 150});
+    to.setOrientationSizes(Qt::Horizontal, {200, 400, 200});
+
+    // Hides, moves, view modes, shows and sizes, in the order of the enumeration
+    auto ops = diffLayouts(from, to);
+    for (int i = 1; i < ops.size(); ++i) {
+        QVERIFY2(ops.at(i - 1).type <= ops.at(i).type, qPrintable(QString("at %1").arg(i)));
+    }
+    QCOMPARE(count(ops, Operation::Hide), 2);
+    QCOMPARE(count(ops, Operation::SetViewMode), 3);
+    QCOMPARE(count(ops, Operation::Show), 2);
+    QCOMPARE(count(ops, Operation::SetSizes), 2);
+    QCOMPARE(applied(from, ops), to);
+}
+
+void tst_DockLayout::unlistedKeepPlacement() {
+    DockLayout from;
+    from.setItems(Qt::LeftEdge, Front, {item("a"), item("b", true), item("c")});
+    DockLayout to;
+    to.setItems(Qt::LeftEdge, Front, items({"c", "a"}));
+
+    // Not mentioned, "b" stays as it is after the listed ones
+    DockLayout expected;
+    expected.setItems(Qt::LeftEdge, Front, {item("c"), item("a"), item("b", true)});
+
+    auto ops = diffLayouts(from, to);
+    QCOMPARE(count(ops, Operation::Hide) + count(ops, Operation::Show), 0);
+    QCOMPARE(applied(from, ops), expected);
+}
+
+void tst_DockLayout::unknownIdsIgnored() {
+    DockLayout from;
+    from.setItems(Qt::LeftEdge, Front, items({"a", "b"}));
+    DockLayout to;
+    to.setItems(Qt::LeftEdge, Front, items({"x", "b", "a", "b"}));
+
+    DockLayout expected;
+    expected.setItems(Qt::LeftEdge, Front, items({"b", "a"}));
+
+    auto ops = diffLayouts(from, to);
+    QCOMPARE(int(ops.size()), 1);
+    QCOMPARE(applied(from, ops), expected);
+}
+
+void tst_DockLayout::randomMinimal() {
+    QRandomGenerator rng(20240612);
+
+    for (int n = 0; n < 500; ++n) {
+        // Every id listed in both layouts, spread over random lists
+        int size = int(rng.bounded(0, 24));
+        QList<DockLayout::Item> from[8];
+        QList<DockLayout::Item> to[8];
+        for (int i = 0; i < size; ++i) {
+            auto id = QString::number(i);
+            from[rng.bounded(8)].append(item(id, rng.bounded(2), ViewMode(rng.bounded(4))));
+            to[rng.bounded(8)].append(item(id, rng.bounded(2), ViewMode(rng.bounded(4))));
+        }
+        for (auto &list : to) {
+            std::shuffle(list.begin(), list.end(), rng);
+        }
+
+        DockLayout source, target;
+        for (int i = 0; i < 8; ++i) {
+            source.setItems(edges[i / 2], Side(i % 2), from[i]);
+            target.setItems(edges[i / 2], Side(i % 2), to[i]);
+        }
+
+        auto ops = diffLayouts(source, target);
+        auto message = QString("case %1").arg(n).toLatin1();
+        QVERIFY2(applied(source, ops) == target, message.constData());
+
+        // Tool windows changing list must move, within a list all but the longest run
+        // already in order
+        int minimum = 0;
+        for (int i = 0; i < 8; ++i) {
+            QVector<int> stayers;
+            for (const auto &it : std::as_const(to[i])) {
+                int list, index;
+                locate(source, it.id, &list, &index);
+                if (list == i) {
+                    stayers.append(index);
+                } else {
+                    minimum++;
+                }
+            }
+            minimum += int(stayers.size()) - longestIncreasing(stayers);
+        }
+        QVERIFY2(count(ops, Operation::Move) == minimum, message.constData());
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_DockLayout)
+
+#include "tst_docklayout.moc"
@@ -0,0 +1,175 @@
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryFile>
+#include <QtTest/QtTest>
+
+#include <JetBrainsDockingSystem/dockinputtrace_p.h>
+
+using namespace JBDS;
+
+static DockTrace sampleTrace() {
+    DockTrace res;
+    res.dockSize = QSize(1280, 720);
+    res.horizontalSizes = {200, 880, 200};
+    res.verticalSizes = {0, 520, 200};
+
+    DockTrace::ToolWindow project;
+    project.id = "project";
+    project.visible = true;
+    DockTrace::ToolWindow terminal;
+    terminal.id = "terminal";
+    terminal.edge = Qt::BottomEdge;
+    terminal.side = Back;
+    terminal.viewMode = Undocked;
+    res.toolWindows = {project, terminal};
+
+    res.targets = {"dock", "popup", "tool:terminal"};
+
+    DockTraceEvent press;
+    press.time = 10;
+    press.type = QEvent::MouseButtonPress;
+    press.target = 0;
+    press.pos = QPoint(12, 340);
+    press.button = Qt::LeftButton;
+    press.buttons = Qt::LeftButton;
+
+    DockTraceEvent key;
+    key.time = 250;
+    key.type = QEvent::KeyPress;
+    key.target = 2;
+    key.pos = QPoint(-4, 8);
+    key.modifiers = Qt::ControlModifier;
+    key.key = Qt::Key_L;
+    key.text = "l";
+    key.autoRepeat = true;
+    res.events = {press, key};
+    return res;
+}
+
+static QByteArray written(const DockTrace &trace) {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    return trace.write(&buffer) ? buffer.data() : QByteArray();
+}
+
+static bool readBack(const QByteArray &data, DockTrace *trace) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return trace->read(&buffer);
+}
+
+class tst_InputTrace : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void roundTrip();
+    void truncated();
+    void corrupt_data();
+    void corrupt();
+    void replayerRejectsCorrupt();
+};
+
+void tst_InputTrace::roundTrip() {
+    auto trace = sampleTrace();
+    auto data = written(trace);
+    QVERIFY(!data.isEmpty());
+
+    DockTrace res;
+    QVERIFY(readBack(data, &res));
+    QCOMPARE(res.dockSize, trace.dockSize);
+    QCOMPARE(res.horizontalSizes, trace.horizontalSizes);
+    QCOMPARE(res.verticalSizes, trace.verticalSizes);
+    QCOMPARE(res.targets, trace.targets);
+
+    QCOMPARE(res.toolWindows.size(), trace.toolWindows.size());
+    for (int i = 0; i < trace.toolWindows.size(); ++i) {
+        const auto &a = res.toolWindows.at(i);
+        const auto &b = trace.toolWindows.at(i);
+        QCOMPARE(a.id, b.id);
+        QCOMPARE(a.edge, b.edge);
+        QCOMPARE(a.side, b.side);
+        QCOMPARE(a.viewMode, b.viewMode);
+        QCOMPARE(a.visible, b.visible);
+    }
+
+    QCOMPARE(res.events.size(), trace.events.size());
+    for (int i = 0; i < trace.events.size(); ++i) {
+        const auto &a = res.events.at(i);
+        const auto &b = trace.events.at(i);
+        QCOMPARE(a.time, b.time);
+        QCOMPARE(a.type, b.type);
+        QCOMPARE(a.target, b.target);
+        QCOMPARE(a.pos, b.pos);
+        QCOMPARE(a.modifiers, b.modifiers);
+        QCOMPARE(a.button, b.button);
+        QCOMPARE(a.buttons, b.buttons);
+        QCOMPARE(a.key, b.key);
+        QCOMPARE(a.text, b.text);
+        QCOMPARE(a.autoRepeat, b.autoRepeat);
+    }
+}
+
+void tst_InputTrace::truncated() {
+    auto data = written(sampleTrace());
+    for (int size = 0; size < data.size(); ++size) {
+        DockTrace res;
+        QVERIFY2(!readBack(data.left(size), &res), qPrintable(QString("%1 bytes").arg(size)));
+    }
+}
+
+void tst_InputTrace::corrupt_data() {
+    QTest::addColumn<int>("field");
+    QTest::newRow("side") << 0;
+    QTest::newRow("view-mode") << 1;
+    QTest::newRow("event-type") << 2;
+    QTest::newRow("target") << 3;
+    QTest::newRow("magic") << 4;
+}
+
+void tst_InputTrace::corrupt() {
+    QFETCH(int, field);
+
+    // Written as is, the writer does not check
+    auto trace = sampleTrace();
+    switch (field) {
+        case 0:
+            trace.toolWindows[1].side = Side(2);
+            break;
+        case 1:
+            trace.toolWindows[0].viewMode = ViewMode(Undocked + 1);
+            break;
+        case 2:
+            trace.events[1].type = QEvent::Paint;
+            break;
+        case 3:
+            trace.events[0].target = quint16(trace.targets.size());
+            break;
+        default:
+            break;
+    }
+    auto data = written(trace);
+    if (field == 4) {
+        data[0] = ~data[0];
+    }
+
+    DockTrace res;
+    QVERIFY(!readBack(data, &res));
+}
+
+void tst_InputTrace::replayerRejectsCorrupt() {
+    auto trace = sampleTrace();
+    trace.toolWindows[1].side = Side(-1);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(written(trace));
+    file.close();
+
+    DockInputReplayer replayer;
+    QVERIFY(!replayer.load(file.fileName()));
+    QCOMPARE(replayer.eventCount(), 0);
+    QVERIFY(replayer.layout().items(Qt::BottomEdge, Back).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_InputTrace)
+
+#include "tst_inputtrace.moc"
@@ -0,0 +1,290 @@
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+
+#include <JetBrainsDockingSystem/docklayoutengine_p.h>
+
+using namespace JBDS;
+
+using Engine = DockLayoutEngine;
+
+static Engine::Panel panel(int size, int minimum = 0, int maximum = Engine::Unbounded) {
+    Engine::Panel res;
+    res.visible = true;
+    res.size = size;
+    res.minimum = minimum;
+    res.maximum = maximum;
+    return res;
+}
+
+class tst_LayoutEngine : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void emptyDock();
+    void barsReserveSpace();
+    void requestedSizes();
+    void clampedToRange();
+    void priorityGivesWay();
+    void maximize();
+    void overConstrained();
+    void hiddenPanelKeepsRequest();
+    void crossMinimum();
+
+    void randomInvariants();
+
+    void benchmarkCompute();
+};
+
+void tst_LayoutEngine::emptyDock() {
+    Engine::Input input;
+    input.size = QSize(800, 600);
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.central, QRect(0, 0, 800, 600));
+    QCOMPARE(res.horizontalSizes[1], 800);
+    QCOMPARE(res.verticalSizes[1], 600);
+    for (const auto &rect : res.panels) {
+        QVERIFY(rect.isNull());
+    }
+}
+
+void tst_LayoutEngine::barsReserveSpace() {
+    Engine::Input input;
+    input.size = QSize(800, 600);
+    for (auto &extent : input.barExtents) {
+        extent = 30;
+    }
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.bars[0], QRect(0, 30, 30, 540));
+    QCOMPARE(res.bars[1], QRect(30, 0, 740, 30));
+    QCOMPARE(res.bars[2], QRect(770, 30, 30, 540));
+    QCOMPARE(res.bars[3], QRect(30, 570, 740, 30));
+    QCOMPARE(res.central, QRect(30, 30, 740, 540));
+}
+
+void tst_LayoutEngine::requestedSizes() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.handleWidth = 4;
+    input.panels[0] = panel(200, 50);
+    input.panels[3] = panel(150, 50);
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.horizontalSizes[0], 200);
+    QCOMPARE(res.horizontalSizes[1], 796);
+    QCOMPARE(res.verticalSizes[2], 150);
+    QCOMPARE(res.verticalSizes[1], 446);
+    QCOMPARE(res.panels[0], QRect(0, 0, 200, 446));
+    QCOMPARE(res.central, QRect(204, 0, 796, 446));
+    QCOMPARE(res.panels[3], QRect(0, 450, 1000, 150));
+}
+
+void tst_LayoutEngine::clampedToRange() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.panels[0] = panel(10, 50);
+    input.panels[2] = panel(900, 0, 300);
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.horizontalSizes[0], 50);
+    QCOMPARE(res.horizontalSizes[2], 300);
+    QCOMPARE(res.horizontalSizes[1], 650);
+}
+
+void tst_LayoutEngine::priorityGivesWay() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.centralMinimum = QSize(200, 0);
+    input.panels[0] = panel(600);
+    input.panels[2] = panel(300);
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.horizontalSizes[0], 500);
+    QCOMPARE(res.horizontalSizes[2], 300);
+
+    input.priority = 2;
+    res = Engine::compute(input);
+    QCOMPARE(res.horizontalSizes[0], 600);
+    QCOMPARE(res.horizontalSizes[2], 200);
+}
+
+void tst_LayoutEngine::maximize() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.centralMinimum = QSize(200, 100);
+    input.panels[1] = panel(Engine::Unbounded);
+    input.panels[3] = panel(150);
+    input.priority = 1;
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.verticalSizes[0], 350);
+    QCOMPARE(res.verticalSizes[1], 100);
+    QCOMPARE(res.verticalSizes[2], 150);
+}
+
+void tst_LayoutEngine::overConstrained() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.panels[0] = panel(600, 600);
+    input.panels[2] = panel(600, 600);
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.horizontalSizes[0], 400);
+    QCOMPARE(res.horizontalSizes[1], 0);
+    QCOMPARE(res.horizontalSizes[2], 600);
+}
+
+void tst_LayoutEngine::hiddenPanelKeepsRequest() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.handleWidth = 4;
+    input.panels[1].size = 120;
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.verticalSizes[0], 120);
+    QCOMPARE(res.verticalSizes[1], 600);
+    QVERIFY(res.panels[1].isNull());
+}
+
+void tst_LayoutEngine::crossMinimum() {
+    Engine::Input input;
+    input.size = QSize(1000, 600);
+    input.panels[0] = panel(200);
+    input.panels[0].crossMinimum = 400;
+    input.panels[3] = panel(300);
+
+    auto res = Engine::compute(input);
+    QCOMPARE(res.verticalSizes[1], 400);
+    QCOMPARE(res.verticalSizes[2], 200);
+}
+
+void tst_LayoutEngine::randomInvariants() {
+    QRandomGenerator rng(20240501);
+    auto bounded = [&rng](int lowest, int highest) {
+        return int(rng.bounded(lowest, highest + 1));
+    };
+
+    for (int n = 0; n < 5000; ++n) {
+        Engine::Input input;
+        input.size = QSize(bounded(200, 2000), bounded(200, 2000));
+        input.handleWidth = bounded(0, 8);
+        input.centralMinimum = QSize(bounded(0, 300), bounded(0, 300));
+        input.priority = bounded(-1, 3);
+        for (auto &extent : input.barExtents) {
+            extent = bounded(0, 40);
+        }
+        for (auto &p : input.panels) {
+            p.visible = bounded(0, 1);
+            p.minimum = bounded(0, 150);
+            p.maximum = bounded(0, 3) ? p.minimum + bounded(0, 600) : int(Engine::Unbounded);
+            p.size = bounded(0, 800);
+            p.crossMinimum = bounded(0, 150);
+        }
+
+        auto res = Engine::compute(input);
+        auto message = QString("case %1").arg(n).toLatin1();
+
+        // Every rectangle stays inside the dock and no two overlap
+        QList<QRect> rects;
+        rects << res.central;
+        for (int i = 0; i < 4; ++i) {
+            rects << res.bars[i] << res.panels[i];
+        }
+        QRect bounds(QPoint(), input.size);
+        for (int i = 0; i < rects.size(); ++i) {
+            if (rects[i].isEmpty())
+                continue;
+            QVERIFY2(bounds.contains(rects[i]), message.constData());
+            for (int j = i + 1; j < rects.size(); ++j) {
+                QVERIFY2(!rects[i].intersects(rects[j]), message.constData());
+            }
+        }
+
+        struct Axis {
+            int length;
+            const Engine::Panel *front, *back;
+            int middleMinimum;
+            const int *sizes;
+        };
+        int innerWidth = qMax(0, input.size.width() - input.barExtents[0] - input.barExtents[2]);
+        int innerHeight = qMax(0, input.size.height() - input.barExtents[1] - input.barExtents[3]);
+        int verticalMiddleMinimum = input.centralMinimum.height();
+        for (int i : {0, 2}) {
+            if (input.panels[i].visible)
+                verticalMiddleMinimum = qMax(verticalMiddleMinimum, input.panels[i].crossMinimum);
+        }
+        Axis axes[] = {
+            {innerWidth, &input.panels[0], &input.panels[2], input.centralMinimum.width(),
+             res.horizontalSizes},
+            {innerHeight, &input.panels[1], &input.panels[3], verticalMiddleMinimum,
+             res.verticalSizes},
+        };
+
+        for (const auto &axis : axes) {
+            int handles = int(axis.front->visible) + int(axis.back->visible);
+            int available = qMax(0, axis.length - handles * input.handleWidth);
+            int used = axis.sizes[1];
+            int minimums = axis.middleMinimum;
+            int requests = axis.middleMinimum;
+            const Engine::Panel *panels[] = {axis.front, axis.back};
+            for (int k = 0; k < 2; ++k) {
+                QVERIFY2(axis.sizes[k * 2] >= 0, message.constData());
+                if (!panels[k]->visible)
+                    continue;
+                used += axis.sizes[k * 2];
+                minimums += panels[k]->minimum;
+                requests += qBound(panels[k]->minimum, panels[k]->size,
+                                   qMax(panels[k]->minimum, panels[k]->maximum));
+            }
+            QVERIFY2(axis.sizes[1] >= 0, message.constData());
+            QCOMPARE(used, available);
+
+            // Constraints hold whenever they can be satisfied at all
+            if (minimums <= available) {
+                QVERIFY2(axis.sizes[1] >= axis.middleMinimum, message.constData());
+                for (int k = 0; k < 2; ++k) {
+                    if (!panels[k]->visible)
+                        continue;
+                    QVERIFY2(axis.sizes[k * 2] >= panels[k]->minimum, message.constData());
+                    QVERIFY2(axis.sizes[k * 2] <=
+                                 qMax(panels[k]->minimum, panels[k]->maximum),
+                             message.constData());
+                }
+            }
+
+            // Requests are honored exactly when they fit
+            if (requests <= available) {
+                for (int k = 0; k < 2; ++k) {
+                    if (!panels[k]->visible)
+                        continue;
+                    QCOMPARE(axis.sizes[k * 2],
+                             qBound(panels[k]->minimum, panels[k]->size,
+                                    qMax(panels[k]->minimum, panels[k]->maximum)));
+                }
+            }
+        }
+    }
+}
+
+void tst_LayoutEngine::benchmarkCompute() {
+    Engine::Input input;
+    input.size = QSize(1920, 1080);
+    input.handleWidth = 4;
+    input.centralMinimum = QSize(200, 200);
+    for (auto &extent : input.barExtents) {
+        extent = 28;
+    }
+    for (auto &p : input.panels) {
+        p = panel(300, 80);
+    }
+
+    Engine::Result res;
+    QBENCHMARK {
+        res = Engine::compute(input);
+    }
+    QVERIFY(!res.central.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_LayoutEngine)
+
+#include "tst_layoutengine.moc"
@@ -1,56 +1,87 @@
 #include "MainWindow.h"
 
+#include <QApplication>
 #include <QDebug>
 #include <QLabel>
+#include <QShortcut>
+
+#include <JetBrainsDockingSystem/dockinputtrace.h>
+#include <JetBrainsDockingSystem/dockprofiler.h>
+#include <JetBrainsDockingSystem/jbdstrace.h>
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     dock = new JBDS::DockWidget();
     dock->setDockAttribute(JBDS::DockWidget::ViewModeContextMenu, true);
     setCentralWidget(dock);
 
-    dock->addWidget(Qt::LeftEdge, JBDS::Front, new QLabel("123"))->setText("123");
-    dock->addWidget(Qt::LeftEdge, JBDS::Front, new QLabel("456"))->setText("456");
-    dock->addWidget(Qt::RightEdge, JBDS::Front, new QLabel("789"))->setText("789");
-
-    resize(1280, 720);
-
-    setStyleSheet(R"(
-
-MainWindow {
-    background-color: #ffffff;
-}
-
-QLabel {
-    padding: 50px;
-}
-
-
-JBDS--DockWidget {
-    background-color: transparent;
-}
-
-JBDS--DockWidget>JBDS--DockSideBar {
-    padding: 3px;
-    qproperty-buttonSpacing: 6;
-}
-
-JBDS--DockWidget>JBDS--DockSideBar[highlight=false] {
-    background-color: transparent;
-}
+    auto label = [](const QString &text) {
+        auto res = new QLabel(text);
+        res->setMargin(50);
+        return res;
+    };
 
-JBDS--DockWidget>JBDS--DockSideBar[highlight=true] {
-    background-color: #f3f3f3;
-}
-
-JBDS--DockWidget QSplitter#dock-splitter:handle {
-    background-color: red;
-}
+    dock->addWidget(Qt::LeftEdge, JBDS::Front, label("123"))->setText("123");
+    dock->addWidget(Qt::LeftEdge, JBDS::Front, label("456"))->setText("456");
+    dock->addWidget(Qt::RightEdge, JBDS::Front, label("789"))->setText("789");
 
-JBDS--DockWidget JBDS--DockPanel:handle {
-    background-color: red;
-}
+    resize(1280, 720);
 
-    )");
+    // Plain properties instead of a style sheet, which would slow down every polish
+    QPalette pal = palette();
+    pal.setColor(QPalette::Window, Qt::white);
+    setPalette(pal);
+    setAutoFillBackground(true);
+
+    dock->setBarPadding(3);
+    dock->setButtonSpacing(6);
+    dock->setHighlightColor(QColor(0xf3, 0xf3, 0xf3));
+    dock->setHandleColor(Qt::red);
+
+    // Finds a tool window by its title
+    auto find = new QShortcut(QKeySequence("Ctrl+Shift+A"), this);
+    connect(find, &QShortcut::activated, dock, &JBDS::DockWidget::showQuickSwitcher);
+
+    // Goes back to the tool windows used before, release Ctrl to choose
+    auto recent = new QShortcut(QKeySequence("Ctrl+Tab"), this);
+    connect(recent, &QShortcut::activated, dock, [dock]() {
+        dock->showRecentSwitcher(); //
+    });
+    auto oldest = new QShortcut(QKeySequence("Ctrl+Shift+Backtab"), this);
+    connect(oldest, &QShortcut::activated, dock, [dock]() {
+        dock->showRecentSwitcher(true); //
+    });
+
+    // JBDS_RECORD_TRACE=<file>.jbdt records the session for jbds_bench to replay
+    if (auto fileName = qEnvironmentVariable("JBDS_RECORD_TRACE"); !fileName.isEmpty()) {
+        auto recorder = new JBDS::DockInputRecorder(dock, this);
+        recorder->start();
+        connect(qApp, &QCoreApplication::aboutToQuit, recorder, [recorder, fileName]() {
+            recorder->stop();
+            recorder->save(fileName);
+        });
+    }
+
+    // JBDS_TRACE=<file>.json writes the trace points of the session for Perfetto
+    if (auto fileName = qEnvironmentVariable("JBDS_TRACE"); !fileName.isEmpty()) {
+        JBDS::DockTracer::setEnabled(true);
+        connect(qApp, &QCoreApplication::aboutToQuit, this, [fileName]() {
+            JBDS::DockTracer::setEnabled(false);
+            JBDS::DockTracer::saveChromeJson(fileName);
+        });
+    }
+
+    // JBDS_HUD=1 shows frame times and the latest dock operations over the dock
+    if (qEnvironmentVariableIntValue("JBDS_HUD")) {
+        dock->setDockAttribute(JBDS::DockWidget::PerformanceOverlay);
+    }
+
+    // JBDS_PROFILE=1 adds a tool window listing the most expensive tool windows
+    if (qEnvironmentVariableIntValue("JBDS_PROFILE")) {
+        auto profiler = new JBDS::DockProfiler(dock, this);
+        profiler->start();
+        dock->addWidget(Qt::BottomEdge, JBDS::Front, new JBDS::DockProfilerView(profiler))
+            ->setText("Profiler");
+    }
 }
 
 MainWindow::~MainWindow() {
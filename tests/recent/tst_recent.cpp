@@ -0,0 +1,79 @@
+#include <QtTest/QtTest>
+#include <QtWidgets/QLabel>
+
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+using namespace JBDS;
+
+// An empty id leaves the content without an object name
+static QAbstractButton *add(DockWidget &dock, Qt::Edge edge, Side side, const QString &id) {
+    auto label = new QLabel(id.isEmpty() ? QString("no id") : id);
+    label->setObjectName(id);
+    return dock.addWidget(edge, side, label);
+}
+
+static QStringList recentIds(DockWidget &dock) {
+    QStringList res;
+    for (auto button : dock.recentToolWindows()) {
+        res.append(dock.widget(button)->objectName());
+    }
+    return res;
+}
+
+class tst_Recent : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void roundTrip();
+    void unchangedLayout();
+};
+
+void tst_Recent::roundTrip() {
+    DockWidget source;
+    auto a = add(source, Qt::LeftEdge, Front, "a");
+    auto b = add(source, Qt::RightEdge, Front, "b");
+    auto c = add(source, Qt::BottomEdge, Back, "c");
+    auto unnamed = add(source, Qt::TopEdge, Front, QString());
+    for (auto button : {a, unnamed, c, b}) {
+        source.activateToolWindow(button);
+    }
+    QCOMPARE(recentIds(source), QStringList({"b", "c", "", "a"}));
+
+    // Tool windows without an id cannot be found again, they are not saved
+    auto layout = source.currentLayout();
+    QCOMPARE(layout.recentIds(), QStringList({"b", "c", "a"}));
+
+    // Elsewhere on the bars and used in another order
+    DockWidget target;
+    a = add(target, Qt::TopEdge, Back, "a");
+    b = add(target, Qt::LeftEdge, Back, "b");
+    c = add(target, Qt::RightEdge, Back, "c");
+    unnamed = add(target, Qt::TopEdge, Front, QString());
+    for (auto button : {unnamed, a, b, c}) {
+        target.activateToolWindow(button);
+    }
+    QCOMPARE(recentIds(target), QStringList({"c", "b", "a", ""}));
+
+    QVERIFY(target.applyLayout(layout) > 0);
+    QCOMPARE(recentIds(target), QStringList({"b", "c", "a", ""}));
+    QCOMPARE(target.currentLayout().recentIds(), layout.recentIds());
+}
+
+void tst_Recent::unchangedLayout() {
+    DockWidget dock;
+    auto a = add(dock, Qt::LeftEdge, Front, "a");
+    auto b = add(dock, Qt::RightEdge, Front, "b");
+    dock.activateToolWindow(a);
+    dock.activateToolWindow(b);
+    auto layout = dock.currentLayout();
+
+    // Only the history differs, there is nothing else to apply
+    a->setChecked(false);
+    dock.activateToolWindow(a);
+    QCOMPARE(recentIds(dock), QStringList({"a", "b"}));
+    QCOMPARE(dock.applyLayout(layout), 0);
+    QCOMPARE(recentIds(dock), QStringList({"b", "a"}));
+}
+
+QTEST_MAIN(tst_Recent)
+
+#include "tst_recent.moc"
@@ -0,0 +1,44 @@
+#ifndef DRAGHELPER_H
+#define DRAGHELPER_H
+
+#include <QtCore/QCoreApplication>
+#include <QtGui/QCursor>
+#include <QtGui/QtEvents>
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QApplication>
+
+// Mouse input shared by the benchmarks and the stress test, header only
+
+inline void sendMouse(QWidget *w, QEvent::Type type, const QPoint &globalPos) {
+    auto button = (type == QEvent::MouseMove) ? Qt::NoButton : Qt::LeftButton;
+    auto buttons = (type == QEvent::MouseButtonRelease) ? Qt::NoButton : Qt::LeftButton;
+    QMouseEvent event(type, w->mapFromGlobal(globalPos), globalPos, button, buttons,
+                      Qt::NoModifier);
+    QApplication::sendEvent(w, &event);
+}
+
+// Same events as a user drag: press, move past the threshold, then moves to the center of
+// the target and a drop there. Returns false if no drag started, the button is released.
+inline bool dragButton(QAbstractButton *button, QWidget *target, int steps = 10) {
+    auto start = button->mapToGlobal(button->rect().center());
+    sendMouse(button, QEvent::MouseButtonPress, start);
+    sendMouse(button, QEvent::MouseMove, start + QPoint(20, 20));
+    QCoreApplication::processEvents();
+
+    auto label = QApplication::activePopupWidget();
+    if (!label) {
+        sendMouse(button, QEvent::MouseButtonRelease, start);
+        return false;
+    }
+
+    auto end = target->mapToGlobal(target->rect().center());
+    for (int k = 1; k <= steps; ++k) {
+        auto pos = start + (end - start) * k / steps;
+        QCursor::setPos(pos);
+        sendMouse(label, QEvent::MouseMove, pos);
+    }
+    sendMouse(label, QEvent::MouseButtonRelease, end);
+    return true;
+}
+
+#endif // DRAGHELPER_H
@@ -0,0 +1,352 @@
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QLabel>
+
+#include <JetBrainsDockingSystem/docktoolwindowmodel.h>
+#include <JetBrainsDockingSystem/dockwidget.h>
+#include <JetBrainsDockingSystem/dockwidget_p.h>
+
+#include "DragHelper.h"
+
+using namespace JBDS;
+
+// Usage: tst_stress [QtTest options], JBDS_STRESS_STEPS overrides the length of each run
+
+static const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+
+enum Operation {
+    Insert,
+    InsertLazy,
+    Remove,
+    Move,
+    ChangeViewMode,
+    Toggle,
+    Drag,
+    DestroyWidget,
+    OperationCount,
+};
+
+static const char *const operationNames[] = {
+    "insert", "insert-lazy", "remove", "move", "view-mode", "toggle", "drag", "destroy-widget",
+};
+
+// Returns the first broken invariant, empty if the dock is consistent
+static QString checkInvariants(DockWidget *dock) {
+    auto d = DockWidgetPrivate::get(dock);
+
+    int cards = 0;
+    for (int i = 0; i < 4; ++i) {
+        auto bar = d->bars[i];
+        auto panel = d->panels[i];
+        if (!bar) {
+            if (panel && (panel->count(Front) + panel->count(Back)) > 0)
+                return QString("panel %1 has content but no bar").arg(i);
+            continue;
+        }
+        if (bar->edge() != index2edge(i))
+            return QString("bar %1 has edge %2").arg(i).arg(bar->edge());
+
+        for (auto side : {Front, Back}) {
+            int containers = 0;
+            int visiblePinned = 0;
+            for (auto button : bar->buttons(side)) {
+                auto it = d->buttonDataHash.constFind(button);
+                if (it == d->buttonDataHash.constEnd())
+                    return QString("bar %1 holds an unknown button").arg(i);
+                const auto &data = it.value();
+                if (edge2index(data.edge) != i || data.side != side)
+                    return QString("%1 is on bar %2 but recorded elsewhere").arg(data.id).arg(i);
+                if (d->dockVisible(button))
+                    visiblePinned++;
+                if (!data.container)
+                    continue;
+                containers++;
+                if (!panel || panel->indexOf(side, data.container) < 0)
+                    return QString("%1 container is missing from panel %2").arg(data.id).arg(i);
+            }
+            cards += bar->count(side);
+
+            if (visiblePinned > 1)
+                return QString("bar %1 side %2 shows %3 pinned")
+                    .arg(i)
+                    .arg(side)
+                    .arg(visiblePinned);
+            if (panel && panel->count(side) != containers)
+                return QString("panel %1 side %2 holds %3 containers, bar has %4")
+                    .arg(i)
+                    .arg(side)
+                    .arg(panel->count(side))
+                    .arg(containers);
+        }
+    }
+    if (cards != d->buttonDataHash.size())
+        return QString("bars hold %1 buttons, %2 registered").arg(cards).arg(
+            d->buttonDataHash.size());
+
+    int materialized = 0;
+    for (auto it = d->buttonDataHash.constBegin(); it != d->buttonDataHash.constEnd(); ++it) {
+        auto button = it.key();
+        const auto &data = it.value();
+        auto w = data.widget;
+        if (!w) {
+            if (!data.factory)
+                return QString("%1 has neither content nor factory").arg(data.id);
+            continue;
+        }
+        materialized++;
+
+        if (d->widgetIndexes.value(w) != button)
+            return QString("%1 content is not indexed").arg(data.id);
+
+        switch (data.viewMode) {
+            case DockPinned: {
+                if (w->parentWidget() != data.container || w->isWindow())
+                    return QString("pinned %1 is outside of its container").arg(data.id);
+                if (button->isChecked() &&
+                    d->panels[edge2index(data.edge)]->currentWidget(data.side) != data.container)
+                    return QString("pinned %1 is checked but not current").arg(data.id);
+                break;
+            }
+            case Undocked: {
+                if (w->parentWidget() != dock || w->isWindow())
+                    return QString("undocked %1 is not an overlay").arg(data.id);
+                if (w->isVisible() != button->isChecked())
+                    return QString("undocked %1 visibility differs from its button").arg(data.id);
+                break;
+            }
+            case Floating:
+            case Window: {
+                auto window = DockWidgetPrivate::detachedWindow(data);
+                if (!window->isWindow())
+                    return QString("detached %1 is not a window").arg(data.id);
+                if (window->isVisible() != button->isChecked())
+                    return QString("detached %1 visibility differs from its button").arg(data.id);
+                break;
+            }
+        }
+    }
+    if (materialized != d->widgetIndexes.size())
+        return QString("%1 indexed contents for %2 materialized")
+            .arg(d->widgetIndexes.size())
+            .arg(materialized);
+    return {};
+}
+
+class tst_Stress : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void randomSequence_data();
+    void randomSequence();
+};
+
+void tst_Stress::randomSequence_data() {
+    QTest::addColumn<quint32>("seed");
+    QTest::newRow("seed-1") << 1u;
+    QTest::newRow("seed-20240501") << 20240501u;
+    QTest::newRow("seed-424242") << 424242u;
+}
+
+void tst_Stress::randomSequence() {
+    QFETCH(quint32, seed);
+
+    int steps = 1500;
+    if (auto env = qEnvironmentVariableIntValue("JBDS_STRESS_STEPS"); env > 0) {
+        steps = env;
+    }
+
+    QRandomGenerator rng(seed);
+    auto bounded = [&rng](int highest) {
+        return int(rng.bounded(highest));
+    };
+
+    DockWidget dock;
+    dock.setWidget(new QLabel("central"));
+    dock.resize(1280, 720);
+    dock.show();
+
+    // Kept in sync from the batched notifications alone
+    QSet<QAbstractButton *> mirror;
+    auto mirrorChanges = [&mirror](const DockWidget::ChangeSet &changes) {
+        for (auto button : changes.removed) {
+            mirror.remove(button);
+        }
+        for (auto button : changes.added) {
+            mirror.insert(button);
+        }
+    };
+    connect(&dock, &DockWidget::layoutChanged, this, mirrorChanges);
+    DockToolWindowModel model(&dock);
+
+    QList<QAbstractButton *> buttons;
+    QList<qint64> latencies[OperationCount];
+    int serial = 0;
+    int drags = 0;
+    int skippedDrags = 0; // No drag started from a visible button
+
+    for (int step = 0; step < steps; ++step) {
+        auto op = Operation(bounded(OperationCount));
+        if (buttons.isEmpty() && op != InsertLazy) {
+            op = Insert;
+        }
+        auto button = buttons.isEmpty() ? nullptr : buttons.at(bounded(buttons.size()));
+
+        QElapsedTimer timer;
+        timer.start();
+        switch (op) {
+            case Insert:
+            case InsertLazy: {
+                auto id = QString("tool-%1").arg(serial++);
+                auto edge = edges[bounded(4)];
+                auto side = Side(bounded(2));
+                int index = bounded(dock.widgetCount(edge, side) + 1);
+                QAbstractButton *added;
+                if (op == Insert) {
+                    added = dock.insertWidget(edge, side, index, new QLabel(id));
+                } else {
+                    added = dock.insertWidget(edge, side, index, id, [id]() {
+                        return new QLabel(id); //
+                    });
+                }
+                added->setText(id);
+                buttons.append(added);
+                break;
+            }
+            case Remove: {
+                auto w = dock.widget(button);
+                dock.removeWidget(button);
+                buttons.removeOne(button);
+                delete w;
+                break;
+            }
+            case Move: {
+                auto edge = edges[bounded(4)];
+                auto side = Side(bounded(2));
+                dock.moveWidget(button, edge, side, bounded(dock.widgetCount(edge, side) + 1));
+                break;
+            }
+            case ChangeViewMode: {
+                dock.setWindowPolicy(button, DockWidget::WindowPolicy(bounded(3)));
+                dock.setViewMode(button, ViewMode(bounded(4)));
+                break;
+            }
+            case Toggle: {
+                button->toggle();
+                break;
+            }
+            case Drag: {
+                auto target = dock.findChild<QWidget *>(
+                    QStringList{"left-bar", "top-bar", "right-bar", "bottom-bar"}.at(bounded(4)));
+                if (target && button->isVisible()) {
+                    if (dragButton(button, target, 5)) {
+                        drags++;
+                    } else {
+                        skippedDrags++;
+                    }
+                }
+                break;
+            }
+            case DestroyWidget: {
+                // Goes through the destroyed signal like an application deleting its content
+                if (auto w = dock.widget(button)) {
+                    delete w;
+                    buttons.removeOne(button);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        QCoreApplication::processEvents();
+        latencies[op].append(timer.nsecsElapsed() / 1000);
+
+        auto error = checkInvariants(&dock);
+        if (error.isEmpty()) {
+            const auto &hash = DockWidgetPrivate::get(&dock)->buttonDataHash;
+            bool synced = mirror.size() == hash.size();
+            for (auto it = hash.keyBegin(); synced && it != hash.keyEnd(); ++it) {
+                synced = mirror.contains(*it);
+            }
+            if (!synced) {
+                error = "layoutChanged() missed a tool window being added or removed";
+            }
+        }
+        if (error.isEmpty()) {
+            // Row by row in the order of the bars
+            int row = 0;
+            for (int stripe = 0; stripe < 8 && error.isEmpty(); ++stripe) {
+                int order = 0;
+                auto check = [&](QAbstractButton *b, QWidget *) {
+                    auto index = model.index(row++);
+                    if (model.button(index) == b &&
+                        index.data(DockToolWindowModel::OrderRole).toInt() == order++)
+                        return true;
+                    error = QString("model row %1 differs from the bars").arg(index.row());
+                    return false;
+                };
+                dock.forEachToolWindow(index2edge(stripe / 2), Side(stripe % 2), check);
+            }
+            if (error.isEmpty() && row != model.rowCount()) {
+                error = QString("model has %1 rows for %2 tool windows")
+                            .arg(model.rowCount())
+                            .arg(row);
+            }
+        }
+        if (error.isEmpty()) {
+            // The history only links known tool windows, each of them once
+            auto dd = DockWidgetPrivate::get(&dock);
+            QAbstractButton *prev = nullptr;
+            int count = 0;
+            for (auto b = dd->recentHead; b && error.isEmpty(); ++count) {
+                auto it = dd->buttonDataHash.constFind(b);
+                if (it == dd->buttonDataHash.constEnd()) {
+                    error = "activation history links a removed tool window";
+                } else if (it->recentPrev != prev || count == dd->buttonDataHash.size()) {
+                    error = "activation history is not a list";
+                } else {
+                    prev = b;
+                    b = it->recentNext;
+                }
+            }
+        }
+        if (!error.isEmpty()) {
+            auto message = QString("step %1 (%2): %3").arg(step).arg(operationNames[op], error);
+            QFAIL(qPrintable(message));
+        }
+    }
+
+    // Otherwise the drag steps checked nothing
+    if (drags + skippedDrags > 0) {
+        auto message = QString("%1 of %2 drags did not start")
+                           .arg(skippedDrags)
+                           .arg(drags + skippedDrags);
+        QVERIFY2(drags > 0, qPrintable(message));
+        if (skippedDrags > 0) {
+            qInfo().noquote() << message;
+        }
+    }
+
+    // Latency percentiles in microseconds, including the event processing of the step
+    for (int op = 0; op < OperationCount; ++op) {
+        auto &samples = latencies[op];
+        if (samples.isEmpty())
+            continue;
+        std::sort(samples.begin(), samples.end());
+        auto at = [&samples](double p) {
+            return samples.at(qMin(samples.size() - 1, int(samples.size() * p)));
+        };
+        qInfo().noquote() << QString("%1 n=%2 p50=%3 p90=%4 p99=%5 max=%6 us")
+                                 .arg(operationNames[op], -14)
+                                 .arg(samples.size())
+                                 .arg(at(0.5))
+                                 .arg(at(0.9))
+                                 .arg(at(0.99))
+                                 .arg(samples.last());
+    }
+}
+
+QTEST_MAIN(tst_Stress)
+
+#include "tst_stress.moc"
@@ -0,0 +1,162 @@
+#include <algorithm>
+
+#include <QtTest/QAbstractItemModelTester>
+#include <QtTest/QtTest>
+#include <QtWidgets/QLabel>
+
+#include <JetBrainsDockingSystem/docktoolwindowmodel.h>
+#include <JetBrainsDockingSystem/dockwidget.h>
+
+using namespace JBDS;
+
+static const auto reporting = QAbstractItemModelTester::FailureReportingMode::QtTest;
+
+static const Qt::Edge edges[] = {Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge};
+
+static QAbstractButton *add(DockWidget &dock, Qt::Edge edge, Side side, const QString &id) {
+    auto label = new QLabel(id);
+    label->setObjectName(id);
+    return dock.addWidget(edge, side, label);
+}
+
+static QStringList ids(const DockToolWindowModel &model) {
+    QStringList res;
+    for (int i = 0; i < model.rowCount(); ++i) {
+        res.append(model.data(model.index(i), DockToolWindowModel::IdRole).toString());
+    }
+    return res;
+}
+
+// Returns the first row that differs from the bars, empty if the model follows the dock
+static QString compare(const DockToolWindowModel &model, const DockWidget &dock) {
+    int row = 0;
+    for (int i = 0; i < 8; ++i) {
+        auto edge = edges[i / 2];
+        auto side = Side(i % 2);
+        int order = 0;
+        QString error;
+        dock.forEachToolWindow(edge, side, [&](QAbstractButton *button, QWidget *) {
+            auto index = model.index(row++);
+            if (model.button(index) != button ||
+                model.data(index, DockToolWindowModel::EdgeRole).toInt() != int(edge) ||
+                model.data(index, DockToolWindowModel::SideRole).toInt() != int(side) ||
+                model.data(index, DockToolWindowModel::OrderRole).toInt() != order++) {
+                error = QString("row %1").arg(index.row());
+                return false;
+            }
+            return true;
+        });
+        if (!error.isEmpty())
+            return error;
+    }
+    if (row != model.rowCount())
+        return QString("%1 rows for %2 tool windows").arg(model.rowCount()).arg(row);
+    return {};
+}
+
+class tst_ToolWindowModel : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void insertAndRemove();
+    void move();
+    void appearance();
+};
+
+void tst_ToolWindowModel::insertAndRemove() {
+    DockWidget dock;
+    add(dock, Qt::BottomEdge, Back, "bottom");
+    DockToolWindowModel model(&dock);
+    QAbstractItemModelTester tester(&model, reporting);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+
+    auto a = add(dock, Qt::LeftEdge, Front, "a");
+    add(dock, Qt::RightEdge, Front, "right");
+    auto label = new QLabel();
+    label->setObjectName("b");
+    dock.insertWidget(Qt::LeftEdge, Front, 0, label);
+    dock.addWidget(Qt::TopEdge, Back, "lazy", []() { return new QLabel("lazy"); });
+    QCOMPARE(inserted.count(), 4);
+    QCOMPARE(ids(model), QStringList({"b", "a", "lazy", "right", "bottom"}));
+    QCOMPARE(compare(model, dock), QString());
+
+    dock.removeWidget(a);
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(ids(model), QStringList({"b", "lazy", "right", "bottom"}));
+    QCOMPARE(compare(model, dock), QString());
+}
+
+void tst_ToolWindowModel::move() {
+    DockWidget dock;
+    auto a = add(dock, Qt::LeftEdge, Front, "a");
+    auto b = add(dock, Qt::LeftEdge, Front, "b");
+    auto c = add(dock, Qt::LeftEdge, Front, "c");
+    add(dock, Qt::BottomEdge, Back, "d");
+    DockToolWindowModel model(&dock);
+    QAbstractItemModelTester tester(&model, reporting);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+
+    // Within a side, to the front and to the end
+    dock.moveWidget(c, Qt::LeftEdge, Front, 0);
+    QCOMPARE(ids(model), QStringList({"c", "a", "b", "d"}));
+    QCOMPARE(compare(model, dock), QString());
+    dock.moveWidget(c, Qt::LeftEdge, Front);
+    QCOMPARE(compare(model, dock), QString());
+
+    // To a later and to an earlier stripe
+    dock.moveWidget(a, Qt::BottomEdge, Back, 0);
+    QCOMPARE(model.data(model.indexOf(a), DockToolWindowModel::EdgeRole).toInt(),
+             int(Qt::BottomEdge));
+    QCOMPARE(model.data(model.indexOf(a), DockToolWindowModel::OrderRole).toInt(), 0);
+    QCOMPARE(compare(model, dock), QString());
+    dock.moveWidget(a, Qt::TopEdge, Front);
+    QCOMPARE(compare(model, dock), QString());
+    dock.moveWidget(b, Qt::RightEdge, Back);
+    QCOMPARE(compare(model, dock), QString());
+    QVERIFY(moved.count() >= 4);
+
+    // Staying where it is moves no row
+    moved.clear();
+    dock.moveWidget(b, Qt::RightEdge, Back, 0);
+    QCOMPARE(moved.count(), 0);
+    QCOMPARE(compare(model, dock), QString());
+}
+
+void tst_ToolWindowModel::appearance() {
+    DockWidget dock;
+    auto a = add(dock, Qt::LeftEdge, Front, "a");
+    auto b = add(dock, Qt::RightEdge, Back, "b");
+    DockToolWindowModel model(&dock);
+    QAbstractItemModelTester tester(&model, reporting);
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+
+    // The bars are never painted here, a search looks at the buttons
+    dock.findToolWindows(QString());
+    changed.clear();
+
+    a->setText("Renamed");
+    b->setIcon(QIcon(QPixmap(16, 16)));
+    dock.findToolWindows(QString());
+
+    QList<int> rows;
+    for (const auto &args : std::as_const(changed)) {
+        auto roles = args.at(2).value<QVector<int>>();
+        if (roles.contains(Qt::DisplayRole) && roles.contains(Qt::DecorationRole)) {
+            rows.append(args.at(0).value<QModelIndex>().row());
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    QCOMPARE(rows, QList<int>({model.indexOf(a).row(), model.indexOf(b).row()}));
+    QCOMPARE(model.data(model.indexOf(a)).toString(), QString("Renamed"));
+    auto icon = model.data(model.indexOf(b), Qt::DecorationRole).value<QIcon>();
+    QCOMPARE(icon.cacheKey(), b->icon().cacheKey());
+
+    // Nothing changed since
+    changed.clear();
+    dock.findToolWindows(QString());
+    QCOMPARE(changed.count(), 0);
+}
+
+QTEST_MAIN(tst_ToolWindowModel)
+
+#include "tst_toolwindowmodel.moc"